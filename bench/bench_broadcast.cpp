@@ -0,0 +1,25 @@
+#include "benchmarks.hpp"
+#include "bench_players.hpp"
+
+#include <yarrr/chat_message.hpp>
+
+namespace bench
+{
+
+void
+run_broadcast_benchmarks( Harness& harness )
+{
+  for ( const size_t number_of_players : { 10, 100, 1000 } )
+  {
+    test::Services services;
+    Players players( services, number_of_players );
+    const yarrr::ChatMessage message( "Player logged in: Kilgore Trout", "server" );
+
+    harness.run( "broadcast/players:" + std::to_string( number_of_players ), 100,
+        [ &players ]() { players.flush_connections(); },
+        [ &services, &message ]() { yarrrs::broadcast( services.players, message ); } );
+  }
+}
+
+}
+
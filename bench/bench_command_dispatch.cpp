@@ -0,0 +1,46 @@
+#include "benchmarks.hpp"
+#include "../src/command_handler.hpp"
+#include "../src/player.hpp"
+#include "../test/test_services.hpp"
+
+#include <yarrr/command.hpp>
+#include <yarrr/test_connection.hpp>
+
+namespace bench
+{
+
+void
+run_command_dispatch_benchmarks( Harness& harness )
+{
+  test::Services services;
+  test::Connection connection;
+  yarrrs::Player player( services.players, "Kilgore Trout", connection.wrapper, services.command_handler );
+
+  yarrrs::CommandHandler command_handler;
+  const std::vector< std::string > command_names{
+    "mission", "ship", "chat", "party", "whisper", "help", "stats", "dock",
+    "undock", "trade", "scan", "warp", "follow", "invite", "kick", "leave" };
+
+  for ( const auto& name : command_names )
+  {
+    command_handler.register_handler( name,
+        []( const yarrr::Command&, yarrrs::Player& )
+        {
+          return yarrrs::CommandHandler::Result::success();
+        } );
+  }
+
+  const yarrr::Command first_command( { command_names.front(), "list" } );
+  const yarrr::Command last_command( { command_names.back(), "list" } );
+  const yarrr::Command unknown_command( { "unknown", "list" } );
+
+  for ( const auto* command : { &first_command, &last_command, &unknown_command } )
+  {
+    harness.run( "command_execute/" + command->command(), 10000,
+        [ &connection ]() { connection.flush_connection(); },
+        [ &command_handler, command, &player ]() { command_handler.execute( *command, player ); } );
+  }
+}
+
+}
+
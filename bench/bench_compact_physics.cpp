@@ -0,0 +1,92 @@
+#include "benchmarks.hpp"
+#include "../src/compact_physics.hpp"
+
+#include <yarrr/object.hpp>
+#include <yarrr/object_container.hpp>
+#include <yarrr/basic_behaviors.hpp>
+
+namespace
+{
+
+const size_t object_count( 64 );
+
+void
+scatter( yarrr::PhysicalParameters& physical_parameters, size_t index, bool is_moving )
+{
+  physical_parameters.coordinate = yarrr::Coordinate(
+      yarrr::Coordinate::type( index * 7919 ) - 250000,
+      yarrr::Coordinate::type( index * 104729 ) - 3000000 );
+  physical_parameters.orientation = yarrr::Angle( index * 37 % 1440 );
+  physical_parameters.integrity = 100;
+  physical_parameters.timestamp = 1445000000000000ll + index * 100000;
+  if ( is_moving )
+  {
+    physical_parameters.velocity = yarrr::Coordinate(
+        yarrr::Coordinate::type( index * 131 % 4000 ) - 2000,
+        yarrr::Coordinate::type( index * 71 % 4000 ) - 2000 );
+    physical_parameters.angular_velocity = yarrr::Angle( index % 5 ) * 40 - 80;
+  }
+}
+
+}
+
+namespace bench
+{
+
+void
+run_compact_physics_benchmarks( Harness& harness )
+{
+  const yarrrs::CompactPhysics compact_physics( yarrrs::CompactPhysics::Quantization::from_configuration() );
+
+  for ( const bool is_moving : { false, true } )
+  {
+    const std::string scene( is_moving ? "moving" : "parked" );
+    yarrr::ObjectContainer objects;
+    std::vector< std::pair< yarrr::Object::Id, const yarrr::PhysicalParameters* > > states;
+    for ( size_t i( 0 ); i < object_count; ++i )
+    {
+      yarrr::Object::Pointer ship( new yarrr::Object() );
+      ship->add_behavior( std::make_unique< yarrr::PhysicalBehavior >() );
+      auto& physical_parameters( yarrr::component_of< yarrr::PhysicalBehavior >( *ship ).physical_parameters );
+      scatter( physical_parameters, i, is_moving );
+      states.emplace_back( ship->id(), &physical_parameters );
+      objects.add_object( std::move( ship ) );
+    }
+
+    const std::vector< yarrr::ObjectUpdate::Pointer > updates( objects.generate_object_updates() );
+    size_t full_bytes( 0 );
+    for ( const auto& update : updates )
+    {
+      full_bytes += update->serialize().size();
+    }
+
+    size_t compact_bytes( 0 );
+    for ( const auto& state : states )
+    {
+      compact_bytes += compact_physics.encode( state.first, *state.second ).size();
+    }
+
+    harness.run( "encode_object_update/full/" + scene, updates.size(),
+        [ &updates ]()
+        {
+          for ( const auto& update : updates )
+          {
+            update->serialize();
+          }
+        } );
+    harness.counter( "bytes_per_update", double( full_bytes ) / updates.size() );
+
+    harness.run( "encode_object_update/compact/" + scene, states.size(),
+        [ &states, &compact_physics ]()
+        {
+          for ( const auto& state : states )
+          {
+            compact_physics.encode( state.first, *state.second );
+          }
+        } );
+    harness.counter( "bytes_per_update", double( compact_bytes ) / states.size() );
+  }
+}
+
+}
+
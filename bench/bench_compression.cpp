@@ -0,0 +1,138 @@
+#include "benchmarks.hpp"
+#include "../src/compression.hpp"
+
+#include <yarrr/chat_message.hpp>
+#include <yarrr/command.hpp>
+#include <yarrr/modell.hpp>
+#include <yarrr/id_generator.hpp>
+#include <yarrr/test_db.hpp>
+#include <yarrr/object.hpp>
+#include <yarrr/object_container.hpp>
+#include <yarrr/basic_behaviors.hpp>
+#include <yarrr/protocol.hpp>
+#include <themodel/lua.hpp>
+
+namespace
+{
+
+class MessageKind
+{
+  public:
+    std::string name;
+    std::vector< yarrr::Data > messages;
+};
+
+std::vector< MessageKind >
+create_message_mix()
+{
+  std::vector< MessageKind > mix;
+
+  mix.push_back( { "help_chat", {
+      yarrr::ChatMessage(
+        "commands: /mission list, /mission request <mission name>, /ship list, /ship request <object type>",
+        "server" ).serialize(),
+      yarrr::ChatMessage(
+        "Welcome to yarrr. If this is the first time you log in to yarrr type in the following command: /mission request tutorial",
+        "server" ).serialize(),
+      yarrr::ChatMessage(
+        "You can always roll back to this text with the page up key. Fair winds and following seas.",
+        "server" ).serialize() } } );
+
+  mix.push_back( { "short_chat", {
+      yarrr::ChatMessage( "Player logged in: Kilgore Trout", "server" ).serialize(),
+      yarrr::ChatMessage( "gg", "Kilgore Trout" ).serialize() } } );
+
+  mix.push_back( { "object_assigned", {
+      yarrr::Command( { yarrr::Protocol::object_assigned, "1234567" } ).serialize() } } );
+
+  static the::model::Lua lua;
+  static yarrr::IdGenerator id_generator;
+  static test::Db database;
+  static yarrr::ModellContainer modells( lua, id_generator, database );
+  auto& player( modells.create_with_id_if_needed( "player", "KilgoreTrout" ) );
+  player[ yarrr::model::availability ] = "online";
+  player[ yarrr::model::auth_token ] = std::string( 64, 'f' );
+  auto& character( modells.create( "character" ) );
+  character[ yarrr::model::name ] = "KilgoreTrout";
+  player[ yarrr::model::character_id ] = character.get( yarrr::model::id );
+  auto& object( modells.create( "object" ) );
+  object[ yarrr::model::object_type ] = yarrr::model::player_controlled;
+  object[ yarrr::model::ship_type ] = "ship";
+  object[ yarrr::model::realtime_object_id ] = "1234567";
+  mix.push_back( { "model_dump", {
+      yarrr::ModellSerializer( player ).serialize(),
+      yarrr::ModellSerializer( character ).serialize(),
+      yarrr::ModellSerializer( object ).serialize() } } );
+
+  yarrr::ObjectContainer objects;
+  for ( int i( 0 ); i < 16; ++i )
+  {
+    yarrr::Object::Pointer ship( new yarrr::Object() );
+    ship->add_behavior( std::make_unique< yarrr::PhysicalBehavior >() );
+    objects.add_object( std::move( ship ) );
+  }
+
+  MessageKind updates{ "object_update", {} };
+  for ( const auto& update : objects.generate_object_updates() )
+  {
+    updates.messages.push_back( update->serialize() );
+  }
+  mix.push_back( std::move( updates ) );
+
+  return mix;
+}
+
+}
+
+namespace bench
+{
+
+void
+run_compression_benchmarks( Harness& harness )
+{
+  const yarrrs::Compressor compressor( yarrrs::Compressor::threshold_from_configuration() );
+
+  for ( const auto& kind : create_message_mix() )
+  {
+    size_t raw_bytes( 0 );
+    size_t sent_bytes( 0 );
+    std::vector< yarrr::Data > compressed_messages;
+    for ( const auto& message : kind.messages )
+    {
+      compressed_messages.push_back( yarrrs::lz::compress( message ) );
+      raw_bytes += message.size();
+      sent_bytes += compressor.compress_if_worth_it( yarrr::Data( message ) ).size();
+    }
+
+    size_t compressed_bytes( 0 );
+    for ( const auto& compressed : compressed_messages )
+    {
+      compressed_bytes += compressed.size();
+    }
+
+    harness.run( "lz_compress/" + kind.name, 1000,
+        [ &kind ]()
+        {
+          for ( const auto& message : kind.messages )
+          {
+            yarrrs::lz::compress( message );
+          }
+        } );
+    harness.counter( "raw_bytes", raw_bytes );
+    harness.counter( "lz_bytes", compressed_bytes );
+    harness.counter( "sent_bytes", sent_bytes );
+
+    yarrr::Data decompressed;
+    harness.run( "lz_decompress/" + kind.name, 1000,
+        [ &compressed_messages, &decompressed ]()
+        {
+          for ( const auto& compressed : compressed_messages )
+          {
+            yarrrs::lz::decompress( compressed, decompressed );
+          }
+        } );
+  }
+}
+
+}
+
@@ -0,0 +1,116 @@
+#include "benchmarks.hpp"
+#include "../src/dead_reckoning.hpp"
+
+#include <thetime/clock.hpp>
+
+#include <cmath>
+
+namespace
+{
+
+const int trace_length( 600 );
+const int64_t tick_length( the::time::Clock::ticks_per_second / 10 );
+
+using Trace = std::vector< yarrr::PhysicalParameters >;
+
+//Advances the object by one tick the way the simulation does, then lets
+//steer change its velocities for the next tick.
+template < typename Steer >
+Trace
+trace_of( yarrr::PhysicalParameters physical_parameters, Steer steer )
+{
+  Trace trace;
+  for ( int tick( 0 ); tick < trace_length; ++tick )
+  {
+    trace.push_back( physical_parameters );
+    physical_parameters = yarrrs::DeadReckoning::extrapolate( physical_parameters, physical_parameters.timestamp + tick_length );
+    steer( tick, physical_parameters );
+  }
+
+  return trace;
+}
+
+std::vector< std::pair< std::string, Trace > >
+create_traces()
+{
+  std::vector< std::pair< std::string, Trace > > traces;
+
+  traces.emplace_back( "parked", trace_of( yarrr::PhysicalParameters(), []( int, yarrr::PhysicalParameters& ){} ) );
+
+  yarrr::PhysicalParameters cruising;
+  cruising.velocity = yarrr::Coordinate( 3000, 1000 );
+  traces.emplace_back( "cruising", trace_of( cruising, []( int, yarrr::PhysicalParameters& ){} ) );
+
+  yarrr::PhysicalParameters spinning;
+  spinning.angular_velocity = 200;
+  traces.emplace_back( "spinning", trace_of( spinning, []( int, yarrr::PhysicalParameters& ){} ) );
+
+  yarrr::PhysicalParameters orbiting;
+  orbiting.velocity = yarrr::Coordinate( 3000, 0 );
+  traces.emplace_back( "orbiting", trace_of( orbiting,
+        []( int tick, yarrr::PhysicalParameters& physical_parameters )
+        {
+          const double angle( tick * 0.05 );
+          physical_parameters.velocity.x = yarrr::Coordinate::type( 3000 * std::cos( angle ) );
+          physical_parameters.velocity.y = yarrr::Coordinate::type( 3000 * std::sin( angle ) );
+        } ) );
+
+  //thrusts in bursts of a few ticks, like a player tapping the keys
+  traces.emplace_back( "dogfighting", trace_of( yarrr::PhysicalParameters(),
+        []( int tick, yarrr::PhysicalParameters& physical_parameters )
+        {
+          if ( tick % 7 < 3 )
+          {
+            physical_parameters.velocity.x += tick % 2 ? 400 : -150;
+            physical_parameters.angular_velocity = tick % 3 ? 150 : -150;
+          }
+          else
+          {
+            physical_parameters.angular_velocity = 0;
+          }
+        } ) );
+
+  return traces;
+}
+
+}
+
+namespace bench
+{
+
+void
+run_dead_reckoning_benchmarks( Harness& harness )
+{
+  const yarrrs::DeadReckoning::Tolerances tolerances( yarrrs::DeadReckoning::Tolerances::from_configuration() );
+  const yarrr::Object::Id id( 1 );
+
+  for ( const auto& trace : create_traces() )
+  {
+    size_t sent_updates( 0 );
+    yarrrs::DeadReckoning counting( tolerances );
+    for ( size_t tick( 0 ); tick < trace.second.size(); ++tick )
+    {
+      sent_updates += counting.is_update_needed( id, trace.second[ tick ], tick ) ? 1 : 0;
+    }
+
+    std::unique_ptr< yarrrs::DeadReckoning > dead_reckoning;
+    size_t tick( 0 );
+    harness.run( "dead_reckoning/" + trace.first, trace.second.size(),
+        [ &dead_reckoning, &tick, &tolerances ]()
+        {
+          dead_reckoning = std::make_unique< yarrrs::DeadReckoning >( tolerances );
+          tick = 0;
+        },
+        [ &dead_reckoning, &tick, &trace, id ]()
+        {
+          dead_reckoning->is_update_needed( id, trace.second[ tick ], tick );
+          ++tick;
+        } );
+    harness.counter( "ticks", trace.second.size() );
+    harness.counter( "sent_updates", sent_updates );
+    harness.counter( "saved_percent", 100.0 * ( trace.second.size() - sent_updates ) / trace.second.size() );
+  }
+}
+
+}
+
@@ -0,0 +1,49 @@
+#include "benchmarks.hpp"
+#include "../src/login_handler.hpp"
+#include "../test/test_services.hpp"
+
+#include <yarrr/command.hpp>
+#include <yarrr/crypto.hpp>
+#include <yarrr/protocol.hpp>
+#include <yarrr/test_connection.hpp>
+
+namespace bench
+{
+
+void
+run_login_benchmarks( Harness& harness )
+{
+  test::Services services;
+  the::ctci::Dispatcher dispatcher;
+  const std::string auth_token( "auth token" );
+
+  size_t number_of_registrations( 0 );
+  harness.run( "login_handler/registration", 100,
+      [ &dispatcher, &auth_token, &number_of_registrations ]()
+      {
+        test::Connection connection;
+        yarrrs::LoginHandler login_handler( connection.wrapper, dispatcher );
+        connection.wrapper.dispatch( yarrr::Command{ {
+            yarrr::Protocol::registration_request,
+            "registered" + std::to_string( number_of_registrations++ ),
+            auth_token } } );
+      } );
+
+  const std::string username( "Kilgore Trout" );
+  services.modell_container.create_with_id_if_needed( "player", username )[ yarrr::model::auth_token ] = auth_token;
+  harness.run( "login_handler/login_and_authentication", 100,
+      [ &dispatcher, &auth_token, &username ]()
+      {
+        test::Connection connection;
+        yarrrs::LoginHandler login_handler( connection.wrapper, dispatcher );
+        connection.wrapper.dispatch( yarrr::Command{ { yarrr::Protocol::login_request, username } } );
+
+        const auto challenge( connection.get_entity< yarrr::Command >()->parameters().back() );
+        connection.wrapper.dispatch( yarrr::Command{ {
+            yarrr::Protocol::authentication_response,
+            yarrr::auth_hash( challenge + auth_token ) } } );
+      } );
+}
+
+}
+
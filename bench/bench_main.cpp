@@ -0,0 +1,22 @@
+#include "benchmarks.hpp"
+
+#include <iostream>
+
+int main( int argc, char** argv )
+{
+  bench::Harness harness( bench::Options::from_arguments( argc, argv ) );
+
+  bench::run_broadcast_benchmarks( harness );
+  bench::run_object_update_benchmarks( harness );
+  bench::run_command_dispatch_benchmarks( harness );
+  bench::run_login_benchmarks( harness );
+  bench::run_model_synchronization_benchmarks( harness );
+  bench::run_compression_benchmarks( harness );
+  bench::run_ship_pool_benchmarks( harness );
+  bench::run_dead_reckoning_benchmarks( harness );
+  bench::run_compact_physics_benchmarks( harness );
+
+  harness.report( std::cout );
+  return 0;
+}
+
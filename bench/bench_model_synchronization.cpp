@@ -0,0 +1,35 @@
+#include "benchmarks.hpp"
+#include "../src/player.hpp"
+#include "../test/test_services.hpp"
+
+#include <yarrr/modell.hpp>
+
+namespace bench
+{
+
+void
+run_model_synchronization_benchmarks( Harness& harness )
+{
+  test::Services services;
+  const std::string player_name( "Kilgore Trout" );
+  auto bundle( services.create_player( player_name ) );
+  auto& player_model( services.modell_container.create_with_id_if_needed( "player", player_name ) );
+
+  size_t number_of_changes( 0 );
+  for ( const size_t changes_per_tick : { 1, 10 } )
+  {
+    harness.run( "model_synchronization/changes_per_tick:" + std::to_string( changes_per_tick ), 1000,
+        [ &bundle ]() { bundle->connection.flush_connection(); },
+        [ &bundle, &player_model, &number_of_changes, changes_per_tick ]()
+        {
+          for ( size_t i( 0 ); i < changes_per_tick; ++i )
+          {
+            player_model[ "a_key" ] = std::to_string( number_of_changes++ );
+          }
+          bundle->player.flush_model_changes();
+        } );
+  }
+}
+
+}
+
@@ -0,0 +1,83 @@
+#include "benchmarks.hpp"
+#include "bench_players.hpp"
+#include "../src/object_updates.hpp"
+#include "../src/worker_pool.hpp"
+#include "../src/zones.hpp"
+
+#include <yarrr/object.hpp>
+#include <yarrr/object_container.hpp>
+#include <yarrr/basic_behaviors.hpp>
+
+namespace bench
+{
+
+void
+run_object_update_benchmarks( Harness& harness )
+{
+  const std::vector< std::pair< size_t, size_t > > players_and_objects{
+    { 10, 100 }, { 100, 100 }, { 100, 1000 }, { 500, 1000 } };
+  const yarrrs::UpdatePriorities priorities( yarrrs::UpdatePriorities::from_configuration() );
+  const yarrrs::CompactPhysics compact_physics( yarrrs::CompactPhysics::Quantization::from_configuration() );
+
+  for ( const auto& setup : players_and_objects )
+  {
+    test::Services services;
+    Players players( services, setup.first );
+
+    yarrr::ObjectContainer objects;
+    for ( size_t i( 0 ); i < setup.second; ++i )
+    {
+      yarrr::Object::Pointer ship( new yarrr::Object() );
+      ship->add_behavior( std::make_unique< yarrr::PhysicalBehavior >() );
+      objects.add_object( std::move( ship ) );
+    }
+
+    harness.run(
+        "send_object_updates/players:" + std::to_string( setup.first ) +
+        "/objects:" + std::to_string( setup.second ), 5,
+        [ &players ]() { players.flush_connections(); },
+        [ &services, &objects, &priorities, &compact_physics ]()
+        {
+          yarrrs::send_object_updates( objects, services.players, priorities, compact_physics );
+        } );
+  }
+
+  //the same ships spread over a 10x10 grid of zones, with one zone between
+  //neighbouring ships
+  const yarrr::Coordinate::type zone_size( 100000 );
+  yarrrs::WorkerPool workers( yarrrs::WorkerPool::threads_from_configuration() );
+  for ( const auto& setup : players_and_objects )
+  {
+    test::Services services;
+    Players players( services, setup.first );
+    yarrrs::Zones zones( zone_size, workers );
+
+    yarrr::ObjectContainer objects;
+    for ( size_t i( 0 ); i < setup.second; ++i )
+    {
+      yarrr::Object::Pointer ship( new yarrr::Object() );
+      ship->add_behavior( std::make_unique< yarrr::PhysicalBehavior >() );
+      yarrr::component_of< yarrr::PhysicalBehavior >( *ship ).physical_parameters.coordinate = yarrr::Coordinate(
+          yarrr::Coordinate::type( i % 10 ) * zone_size * 2,
+          yarrr::Coordinate::type( i / 10 % 10 ) * zone_size * 2 );
+      objects.add_object( std::move( ship ) );
+    }
+
+    harness.run(
+        "send_object_updates_in_zones/players:" + std::to_string( setup.first ) +
+        "/objects:" + std::to_string( setup.second ), 5,
+        [ &players ]() { players.flush_connections(); },
+        [ &services, &objects, &priorities, &compact_physics, &zones ]()
+        {
+          yarrrs::send_object_updates(
+              objects, services.players,
+              priorities,
+              compact_physics,
+              yarrrs::DistantUpdates{ 0, 1, 0 },
+              &zones );
+        } );
+  }
+}
+
+}
+
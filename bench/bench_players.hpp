@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../test/test_services.hpp"
+
+#include <string>
+#include <vector>
+
+namespace bench
+{
+
+//Players logged in to a test::Services instance for the benchmarks, each with
+//its own test connection.
+class Players
+{
+  public:
+    Players( test::Services& services, size_t number_of_players )
+    {
+      for ( size_t i( 0 ); i < number_of_players; ++i )
+      {
+        auto bundle( services.create_player( "player" + std::to_string( i ) ) );
+        services.players[ bundle->connection.connection->id ] = bundle->take_player_ownership();
+        bundles.emplace_back( std::move( bundle ) );
+      }
+    }
+
+    void flush_connections()
+    {
+      for ( auto& bundle : bundles )
+      {
+        bundle->connection.flush_connection();
+      }
+    }
+
+    std::vector< test::Services::PlayerBundle::Pointer > bundles;
+};
+
+}
+
@@ -0,0 +1,63 @@
+#include "benchmarks.hpp"
+#include "../src/ship_pool.hpp"
+
+#include <yarrr/object.hpp>
+#include <yarrr/object_factory.hpp>
+#include <yarrr/basic_behaviors.hpp>
+#include <yarrr/destruction_handlers.hpp>
+#include <yarrr/object_identity.hpp>
+
+namespace
+{
+
+const std::string ship_type( "ship" );
+const size_t respawns_per_repetition( 4 );
+
+yarrr::Object::Pointer
+build_ship()
+{
+  yarrr::Object::Pointer ship( new yarrr::Object() );
+  ship->add_behavior( std::make_unique< yarrr::PhysicalBehavior >() );
+  return ship;
+}
+
+//Same as the tick path of a respawn in World: take a ship, then give it a captain.
+yarrr::Object::Pointer
+respawn_with( yarrrs::ShipPool& pool )
+{
+  yarrr::Object::Pointer ship( pool.acquire( ship_type ) );
+  ship->add_behavior( yarrr::kill_player_when_destroyed() );
+  ship->add_behavior( std::make_unique< yarrr::ObjectIdentity >( "Kilgore Trout" ) );
+  return ship;
+}
+
+}
+
+namespace bench
+{
+
+void
+run_ship_pool_benchmarks( Harness& harness )
+{
+  yarrr::ObjectFactory factory;
+  factory.register_creator( ship_type, build_ship );
+  std::vector< yarrr::Object::Pointer > wrecks;
+
+  yarrrs::ShipPool without_spares( factory, 0 );
+  harness.run( "respawn/factory", respawns_per_repetition,
+      [ &wrecks ]() { wrecks.clear(); },
+      [ &wrecks, &without_spares ]() { wrecks.push_back( respawn_with( without_spares ) ); } );
+
+  yarrrs::ShipPool with_spares( factory, respawns_per_repetition );
+  with_spares.keep_spares_of( ship_type );
+  harness.run( "respawn/pool", respawns_per_repetition,
+      [ &wrecks, &with_spares ]()
+      {
+        wrecks.clear();
+        with_spares.refill( respawns_per_repetition );
+      },
+      [ &wrecks, &with_spares ]() { wrecks.push_back( respawn_with( with_spares ) ); } );
+}
+
+}
+
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "harness.hpp"
+
+namespace bench
+{
+
+void run_broadcast_benchmarks( Harness& );
+void run_object_update_benchmarks( Harness& );
+void run_command_dispatch_benchmarks( Harness& );
+void run_login_benchmarks( Harness& );
+void run_model_synchronization_benchmarks( Harness& );
+void run_compression_benchmarks( Harness& );
+void run_ship_pool_benchmarks( Harness& );
+void run_dead_reckoning_benchmarks( Harness& );
+void run_compact_physics_benchmarks( Harness& );
+
+}
+
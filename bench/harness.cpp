@@ -0,0 +1,240 @@
+#include "harness.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <numeric>
+
+namespace
+{
+
+std::atomic< size_t > number_of_allocations( 0 );
+
+std::string
+escape_json( const std::string& text )
+{
+  std::string escaped;
+  for ( const char character : text )
+  {
+    if ( character == '"' || character == '\\' )
+    {
+      escaped += '\\';
+    }
+    escaped += character;
+  }
+  return escaped;
+}
+
+}
+
+void*
+operator new( size_t size )
+{
+  ++number_of_allocations;
+  void* memory( std::malloc( size ? size : 1 ) );
+  if ( !memory )
+  {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+void
+operator delete( void* memory ) noexcept
+{
+  std::free( memory );
+}
+
+void
+operator delete( void* memory, size_t ) noexcept
+{
+  std::free( memory );
+}
+
+namespace bench
+{
+
+size_t
+allocation_count()
+{
+  return number_of_allocations;
+}
+
+Options
+Options::from_arguments( int argc, char** argv )
+{
+  Options options{ 3, 20, "", false };
+  for ( int i( 1 ); i < argc; ++i )
+  {
+    const std::string argument( argv[ i ] );
+    const bool has_value( i + 1 < argc );
+    if ( argument == "--json" )
+    {
+      options.json = true;
+    }
+    else if ( argument == "--warmup" && has_value )
+    {
+      options.warmup_repetitions = std::stoul( argv[ ++i ] );
+    }
+    else if ( argument == "--repetitions" && has_value )
+    {
+      options.repetitions = std::max< size_t >( 1, std::stoul( argv[ ++i ] ) );
+    }
+    else if ( argument == "--filter" && has_value )
+    {
+      options.filter = argv[ ++i ];
+    }
+  }
+
+  return options;
+}
+
+Result::Result( const std::string& name, size_t operations )
+  : name( name )
+  , operations( operations )
+  , allocations_per_operation( 0 )
+{
+}
+
+void
+Result::add_sample( double nanoseconds, double allocations )
+{
+  nanoseconds_per_operation.push_back( nanoseconds );
+  allocations_per_operation = std::max( allocations_per_operation, allocations );
+}
+
+void
+Result::add_counter( const std::string& name, double value )
+{
+  counters.emplace_back( name, value );
+}
+
+double
+Result::percentile( double ratio ) const
+{
+  if ( nanoseconds_per_operation.empty() )
+  {
+    return 0;
+  }
+
+  std::vector< double > sorted( nanoseconds_per_operation );
+  std::sort( std::begin( sorted ), std::end( sorted ) );
+  const size_t index( std::min( sorted.size() - 1, size_t( ratio * ( sorted.size() - 1 ) + 0.5 ) ) );
+  return sorted[ index ];
+}
+
+double
+Result::mean() const
+{
+  if ( nanoseconds_per_operation.empty() )
+  {
+    return 0;
+  }
+
+  return std::accumulate(
+      std::begin( nanoseconds_per_operation ), std::end( nanoseconds_per_operation ), 0.0 ) /
+    nanoseconds_per_operation.size();
+}
+
+Harness::Harness( const Options& options )
+  : m_options( options )
+  , m_was_last_run_selected( false )
+{
+}
+
+bool
+Harness::is_selected( const std::string& name ) const
+{
+  return name.find( m_options.filter ) != std::string::npos;
+}
+
+void
+Harness::counter( const std::string& name, double value )
+{
+  if ( !m_was_last_run_selected )
+  {
+    return;
+  }
+
+  m_results.back().add_counter( name, value );
+}
+
+void
+Harness::report( std::ostream& output ) const
+{
+  if ( m_options.json )
+  {
+    report_json( output );
+    return;
+  }
+
+  report_table( output );
+}
+
+void
+Harness::report_table( std::ostream& output ) const
+{
+  output
+    << std::left << std::setw( 44 ) << "benchmark" << std::right
+    << std::setw( 12 ) << "p50 ns"
+    << std::setw( 12 ) << "p90 ns"
+    << std::setw( 12 ) << "p99 ns"
+    << std::setw( 12 ) << "allocs/op" << std::endl;
+
+  for ( const auto& result : m_results )
+  {
+    output
+      << std::left << std::setw( 44 ) << result.name << std::right
+      << std::fixed << std::setprecision( 1 )
+      << std::setw( 12 ) << result.percentile( 0.5 )
+      << std::setw( 12 ) << result.percentile( 0.9 )
+      << std::setw( 12 ) << result.percentile( 0.99 )
+      << std::setw( 12 ) << result.allocations_per_operation;
+
+    for ( const auto& counter : result.counters )
+    {
+      output << "  " << counter.first << "=" << counter.second;
+    }
+    output << std::endl;
+  }
+}
+
+void
+Harness::report_json( std::ostream& output ) const
+{
+  output << "{\"warmup\":" << m_options.warmup_repetitions
+    << ",\"repetitions\":" << m_options.repetitions
+    << ",\"benchmarks\":[";
+
+  bool is_first( true );
+  for ( const auto& result : m_results )
+  {
+    output << ( is_first ? "" : "," )
+      << "{\"name\":\"" << escape_json( result.name ) << "\""
+      << ",\"operations\":" << result.operations
+      << ",\"mean_ns\":" << result.mean()
+      << ",\"p50_ns\":" << result.percentile( 0.5 )
+      << ",\"p90_ns\":" << result.percentile( 0.9 )
+      << ",\"p99_ns\":" << result.percentile( 0.99 )
+      << ",\"allocations_per_operation\":" << result.allocations_per_operation
+      << ",\"counters\":{";
+
+    bool is_first_counter( true );
+    for ( const auto& counter : result.counters )
+    {
+      output << ( is_first_counter ? "" : "," )
+        << "\"" << escape_json( counter.first ) << "\":" << counter.second;
+      is_first_counter = false;
+    }
+
+    output << "}}";
+    is_first = false;
+  }
+
+  output << "]}" << std::endl;
+}
+
+}
+
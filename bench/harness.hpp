@@ -0,0 +1,124 @@
+#pragma once
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+
+//Number of global operator new calls since the start of the process.
+size_t allocation_count();
+
+class Options
+{
+  public:
+    static Options from_arguments( int argc, char** argv );
+
+    size_t warmup_repetitions;
+    size_t repetitions;
+    std::string filter;
+    bool json;
+};
+
+class Result
+{
+  public:
+    Result( const std::string& name, size_t operations );
+
+    void add_sample( double nanoseconds_per_operation, double allocations_per_operation );
+    void add_counter( const std::string& name, double value );
+
+    double percentile( double ratio ) const;
+    double mean() const;
+
+    const std::string name;
+    const size_t operations;
+    std::vector< double > nanoseconds_per_operation;
+    double allocations_per_operation;
+    std::vector< std::pair< std::string, double > > counters;
+};
+
+//Runs each benchmark operation in repetitions of a fixed number of calls after
+//a few warmup repetitions, and reports the per call time distribution and
+//allocation count of the repetitions as a table or as JSON.
+class Harness
+{
+  public:
+    Harness( const Options& );
+
+    template < typename Operation >
+    bool run( const std::string& name, size_t operations, Operation operation );
+
+    //The untimed prepare runs before every repetition, e.g. to drop the data
+    //collected by test connections.
+    template < typename Prepare, typename Operation >
+    bool run( const std::string& name, size_t operations, Prepare prepare, Operation operation );
+
+    //Attaches a value to the result of the last benchmark, if it was run.
+    void counter( const std::string& name, double value );
+
+    void report( std::ostream& ) const;
+
+  private:
+    bool is_selected( const std::string& name ) const;
+    void report_table( std::ostream& ) const;
+    void report_json( std::ostream& ) const;
+
+    const Options m_options;
+    std::vector< Result > m_results;
+    bool m_was_last_run_selected;
+};
+
+template < typename Operation >
+bool
+Harness::run( const std::string& name, size_t operations, Operation operation )
+{
+  return run( name, operations, [](){}, operation );
+}
+
+template < typename Prepare, typename Operation >
+bool
+Harness::run( const std::string& name, size_t operations, Prepare prepare, Operation operation )
+{
+  m_was_last_run_selected = is_selected( name );
+  if ( !m_was_last_run_selected )
+  {
+    return false;
+  }
+
+  for ( size_t repetition( 0 ); repetition < m_options.warmup_repetitions; ++repetition )
+  {
+    prepare();
+    for ( size_t i( 0 ); i < operations; ++i )
+    {
+      operation();
+    }
+  }
+
+  Result result( name, operations );
+  for ( size_t repetition( 0 ); repetition < m_options.repetitions; ++repetition )
+  {
+    prepare();
+    const size_t allocations_before( allocation_count() );
+    const auto start( std::chrono::steady_clock::now() );
+    for ( size_t i( 0 ); i < operations; ++i )
+    {
+      operation();
+    }
+    const auto end( std::chrono::steady_clock::now() );
+    const size_t allocations( allocation_count() - allocations_before );
+
+    result.add_sample(
+        std::chrono::duration< double, std::nano >( end - start ).count() / operations,
+        double( allocations ) / operations );
+  }
+
+  m_results.emplace_back( std::move( result ) );
+  return true;
+}
+
+}
+
@@ -0,0 +1,314 @@
+#include "../src/player.hpp"
+#include "../src/world.hpp"
+#include "../src/login_handler.hpp"
+#include "../src/mission_updater.hpp"
+#include "../src/object_updates.hpp"
+#include "../src/tick_histogram.hpp"
+#include "../test/test_services.hpp"
+
+#include <yarrr/basic_behaviors.hpp>
+#include <yarrr/chat_message.hpp>
+#include <yarrr/command.hpp>
+#include <yarrr/object.hpp>
+#include <yarrr/object_container.hpp>
+#include <yarrr/object_factory.hpp>
+#include <yarrr/timer_update.hpp>
+#include <yarrr/test_connection.hpp>
+#include <thetime/clock.hpp>
+#include <thectci/service_registry.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include <unistd.h>
+
+namespace
+{
+
+constexpr int simulation_frequency( 10 );
+
+class Options
+{
+  public:
+    std::vector< size_t > clients;
+    size_t ticks;
+};
+
+Options
+parse_options( int argc, char** argv )
+{
+  Options options{ { 10, 50, 100, 200 }, 300 };
+  for ( int i( 1 ); i + 1 < argc; i += 2 )
+  {
+    const std::string argument( argv[ i ] );
+    if ( argument == "--ticks" )
+    {
+      options.ticks = std::stoul( argv[ i + 1 ] );
+    }
+    else if ( argument == "--clients" )
+    {
+      options.clients.clear();
+      std::stringstream list( argv[ i + 1 ] );
+      std::string number;
+      while ( std::getline( list, number, ',' ) )
+      {
+        options.clients.push_back( std::stoul( number ) );
+      }
+    }
+  }
+
+  return options;
+}
+
+double
+resident_megabytes()
+{
+  std::ifstream statm( "/proc/self/statm" );
+  size_t total_pages( 0 );
+  size_t resident_pages( 0 );
+  statm >> total_pages >> resident_pages;
+  return double( resident_pages ) * sysconf( _SC_PAGESIZE ) / ( 1024.0 * 1024.0 );
+}
+
+//A scripted client: steers its ship every tick, chats, and now and then
+//requests missions and a new ship.  Everything it does arrives at the server
+//the same way as from the network, through its connection wrapper.
+class SimulatedClient
+{
+  public:
+    SimulatedClient( test::Services& services, size_t index )
+      : m_services( services )
+      , m_connection( std::make_unique< test::Connection >() )
+      , m_name( "client" + std::to_string( index ) )
+      , m_id( m_connection->connection->id )
+      , m_phase( index )
+      , m_random( index )
+      , m_is_dropped( false )
+    {
+      services.local_event_dispatcher.dispatcher.dispatch(
+          yarrrs::PlayerLoggedIn( m_connection->wrapper, m_id, m_name ) );
+    }
+
+    int id() const
+    {
+      return m_id;
+    }
+
+    //the server gave up on this client because it could not keep up
+    void drop()
+    {
+      m_services.local_event_dispatcher.dispatcher.dispatch( yarrrs::PlayerLoggedOut( m_id ) );
+      m_is_dropped = true;
+    }
+
+    bool is_dropped() const
+    {
+      return m_is_dropped;
+    }
+
+    void act( size_t tick )
+    {
+      if ( m_is_dropped )
+      {
+        return;
+      }
+
+      const size_t local_tick( tick + m_phase );
+      steer();
+
+      if ( local_tick % 50 == 0 )
+      {
+        m_connection->wrapper.dispatch( yarrr::ChatMessage( "ahoy from " + m_name, m_name ) );
+      }
+
+      if ( local_tick % 100 == 10 )
+      {
+        m_connection->wrapper.dispatch( yarrr::Command( { "mission", "list" } ) );
+        m_connection->wrapper.dispatch( yarrr::Command( { "mission", "request", "tutorial" } ) );
+      }
+
+      if ( local_tick % 300 == 150 )
+      {
+        m_connection->wrapper.dispatch( yarrr::Command( { "ship", "request", "ship" } ) );
+      }
+    }
+
+    void read_messages()
+    {
+      if ( m_is_dropped )
+      {
+        return;
+      }
+
+      m_connection->flush_connection();
+    }
+
+  private:
+    void steer()
+    {
+      const auto player( m_services.players.find( m_id ) );
+      if ( player == std::end( m_services.players ) ||
+           !player->second->has_object() ||
+           !m_services.objects.has_object_with_id( player->second->object_id() ) )
+      {
+        return;
+      }
+
+      auto& ship( m_services.objects.object_with_id( player->second->object_id() ) );
+      auto& velocity( yarrr::component_of< yarrr::PhysicalBehavior >( ship ).physical_parameters.velocity );
+      std::uniform_int_distribution< int > nudge( -100, 100 );
+      velocity.x += nudge( m_random );
+      velocity.y += nudge( m_random );
+    }
+
+    test::Services& m_services;
+    std::unique_ptr< test::Connection > m_connection;
+    const std::string m_name;
+    const int m_id;
+    const size_t m_phase;
+    std::mt19937 m_random;
+    bool m_is_dropped;
+};
+
+class Report
+{
+  public:
+    size_t clients;
+    yarrrs::TickHistogram::Duration p50;
+    yarrrs::TickHistogram::Duration p99;
+    yarrrs::TickHistogram::Duration max;
+    double sent_bytes_per_client_per_tick;
+    size_t dropped_clients;
+    double resident_megabytes;
+};
+
+//as the server does with a player whose queue overflows
+void
+drop_client( std::vector< std::unique_ptr< SimulatedClient > >& clients, int id )
+{
+  for ( auto& client : clients )
+  {
+    if ( client->id() == id && !client->is_dropped() )
+    {
+      client->drop();
+    }
+  }
+}
+
+Report
+run_with( size_t number_of_clients, size_t ticks )
+{
+  test::Services services;
+  yarrrs::World& world( *services.world );
+  const yarrrs::UpdatePriorities priorities( yarrrs::UpdatePriorities::from_configuration() );
+  const yarrrs::CompactPhysics compact_physics( yarrrs::CompactPhysics::Quantization::from_configuration() );
+  yarrrs::MissionUpdater mission_updater( services.players, simulation_frequency );
+  the::time::Clock clock;
+
+  std::vector< std::unique_ptr< SimulatedClient > > clients;
+  for ( size_t i( 0 ); i < number_of_clients; ++i )
+  {
+    clients.emplace_back( std::make_unique< SimulatedClient >( services, i ) );
+    services.main_thread_callback_queue.process_callbacks();
+  }
+
+  size_t sent_bytes_before( 0 );
+  for ( const auto& player : services.players )
+  {
+    sent_bytes_before += player.second->sent_bytes();
+  }
+
+  yarrrs::TickHistogram tick_histogram( std::chrono::milliseconds( 1 ), 1000 / simulation_frequency * 2 );
+  for ( size_t tick( 0 ); tick < ticks; ++tick )
+  {
+    const auto tick_start( std::chrono::steady_clock::now() );
+    for ( auto& client : clients )
+    {
+      client->act( tick );
+    }
+
+    services.objects.dispatch( yarrr::TimerUpdate( clock.now() ) );
+    services.objects.check_collision();
+    for ( const auto& id : yarrrs::send_object_updates( services.objects, services.players, priorities, compact_physics ) )
+    {
+      drop_client( clients, id );
+    }
+    mission_updater.tick();
+    world.tick();
+    for ( auto& player : services.players )
+    {
+      player.second->flush_model_changes();
+    }
+    services.main_thread_callback_queue.process_callbacks();
+    tick_histogram.record( std::chrono::duration_cast< yarrrs::TickHistogram::Duration >(
+          std::chrono::steady_clock::now() - tick_start ) );
+
+    for ( auto& client : clients )
+    {
+      client->read_messages();
+    }
+  }
+
+  size_t sent_bytes( 0 );
+  for ( const auto& player : services.players )
+  {
+    sent_bytes += player.second->sent_bytes();
+  }
+
+  const size_t dropped_clients( std::count_if( std::begin( clients ), std::end( clients ),
+        []( const std::unique_ptr< SimulatedClient >& client ) { return client->is_dropped(); } ) );
+  const double client_ticks( double( std::max< size_t >( 1, number_of_clients ) ) * std::max< size_t >( 1, ticks ) );
+  return Report{
+    number_of_clients,
+    tick_histogram.percentile( 50 ),
+    tick_histogram.percentile( 99 ),
+    tick_histogram.max(),
+    ( sent_bytes - sent_bytes_before ) / client_ticks,
+    dropped_clients,
+    resident_megabytes() };
+}
+
+}
+
+int main( int argc, char** argv )
+{
+  const Options options( parse_options( argc, argv ) );
+  the::ctci::service< yarrr::ObjectFactory >().register_creator( "ship",
+      []()
+      {
+        yarrr::Object::Pointer ship( new yarrr::Object() );
+        ship->add_behavior( std::make_unique< yarrr::PhysicalBehavior >() );
+        return ship;
+      } );
+
+  std::cout << "ticks per run: " << options.ticks
+    << ", tick budget: " << 1000 / simulation_frequency << " ms" << std::endl;
+  std::cout
+    << std::setw( 8 ) << "clients"
+    << std::setw( 12 ) << "p50 us"
+    << std::setw( 12 ) << "p99 us"
+    << std::setw( 12 ) << "max us"
+    << std::setw( 20 ) << "bytes/client/tick"
+    << std::setw( 9 ) << "dropped"
+    << std::setw( 12 ) << "rss MB" << std::endl;
+
+  for ( const auto number_of_clients : options.clients )
+  {
+    const Report report( run_with( number_of_clients, options.ticks ) );
+    std::cout
+      << std::setw( 8 ) << report.clients
+      << std::setw( 12 ) << report.p50.count()
+      << std::setw( 12 ) << report.p99.count()
+      << std::setw( 12 ) << report.max.count()
+      << std::setw( 20 ) << std::fixed << std::setprecision( 1 ) << report.sent_bytes_per_client_per_tick
+      << std::setw( 9 ) << report.dropped_clients
+      << std::setw( 12 ) << report.resident_megabytes << std::endl;
+  }
+
+  return 0;
+}
+
@@ -0,0 +1,67 @@
+#include "capabilities.hpp"
+
+namespace yarrrs
+{
+
+const std::string
+Capabilities::negotiation( "capabilities" );
+
+const std::string
+Capabilities::lz_compression( "lz" );
+
+//The client understands a command named delete_list listing every object
+//deleted in a tick, instead of a separate DeleteObject message per object.
+const std::string
+Capabilities::delete_list( "delete_list" );
+
+//Between keyframes the client accepts the physical state of an object as a
+//quantized compact_physics command instead of a full ObjectUpdate.
+const std::string
+Capabilities::compact_physics( "compact_physics" );
+
+//The client logs in again on another server when it gets a handoff command
+//with the address of that server.
+const std::string
+Capabilities::cluster_handoff( "handoff" );
+
+const Capabilities&
+Capabilities::supported()
+{
+  static const Capabilities supported_capabilities{ lz_compression, delete_list, compact_physics, cluster_handoff };
+  return supported_capabilities;
+}
+
+Capabilities::Capabilities( std::initializer_list< std::string > names )
+  : m_names( names )
+{
+}
+
+bool
+Capabilities::has( const std::string& name ) const
+{
+  return m_names.find( name ) != std::end( m_names );
+}
+
+Capabilities
+Capabilities::negotiate( const std::vector< std::string >& requested ) const
+{
+  Capabilities agreed;
+  for ( const auto& name : requested )
+  {
+    if ( has( name ) )
+    {
+      agreed.m_names.insert( name );
+    }
+  }
+
+  return agreed;
+}
+
+std::vector< std::string >
+Capabilities::names() const
+{
+  return std::vector< std::string >( std::begin( m_names ), std::end( m_names ) );
+}
+
+}
+
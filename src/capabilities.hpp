@@ -0,0 +1,36 @@
+#pragma once
+
+#include <set>
+#include <string>
+#include <vector>
+
+namespace yarrrs
+{
+
+//Optional protocol features agreed on with a client before it logs in.
+//The client sends the capabilities command listing what it understands, the server
+//answers with the same command listing the subset it is going to use.
+class Capabilities
+{
+  public:
+    static const std::string negotiation;
+    static const std::string lz_compression;
+    static const std::string delete_list;
+    static const std::string compact_physics;
+    static const std::string cluster_handoff;
+
+    static const Capabilities& supported();
+
+    Capabilities() = default;
+    Capabilities( std::initializer_list< std::string > names );
+
+    bool has( const std::string& name ) const;
+    Capabilities negotiate( const std::vector< std::string >& requested ) const;
+    std::vector< std::string > names() const;
+
+  private:
+    std::set< std::string > m_names;
+};
+
+}
+
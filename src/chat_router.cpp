@@ -0,0 +1,369 @@
+#include "chat_router.hpp"
+#include "configuration.hpp"
+#include "object_position.hpp"
+
+#include <yarrr/chat_message.hpp>
+#include <yarrr/object_container.hpp>
+#include <yarrr/basic_behaviors.hpp>
+#include <yarrr/log.hpp>
+
+#include <algorithm>
+#include <functional>
+
+namespace
+{
+
+int64_t
+cell_index_of( int64_t coordinate, int64_t cell_size )
+{
+  return coordinate >= 0 ?
+    coordinate / cell_size :
+    ( coordinate - cell_size + 1 ) / cell_size;
+}
+
+void
+send_to( const std::vector< yarrrs::Player* >& recipients, yarrr::Data&& message )
+{
+  yarrrs::hand_out( std::begin( recipients ), std::end( recipients ), std::move( message ),
+      []( yarrrs::Player* recipient, yarrr::Data&& message )
+      {
+        recipient->send( std::move( message ) );
+      } );
+}
+
+void
+notify( const yarrrs::Player& player, const std::string& text )
+{
+  player.send( yarrr::ChatMessage( text, "server" ).serialize() );
+}
+
+}
+
+namespace yarrrs
+{
+
+ChatRouter::State::State( int burst, int ticks_per_token )
+  : channel( global )
+  , party_name()
+  , limiter( burst, ticks_per_token )
+  , is_throttled( false )
+{
+}
+
+size_t
+ChatRouter::CellHash::operator()( const Cell& cell ) const
+{
+  return std::hash< int64_t >()( cell.first ) * 31 + std::hash< int64_t >()( cell.second );
+}
+
+ChatRouter::ChatRouter( const Player::Container& players, yarrr::ObjectContainer& objects )
+  : m_players( players )
+  , m_objects( objects )
+  , m_burst( configured_or< int >( "chat_burst", 5 ) )
+  , m_ticks_per_token( configured_or< int >( "chat_ticks_per_message", 10 ) )
+  , m_proximity_radius( std::max< int64_t >( 1, configured_or< int64_t >( "chat_proximity_radius", 100000 ) ) )
+{
+}
+
+ChatRouter::State&
+ChatRouter::state_of( const Player& player )
+{
+  return m_states.emplace( player.name, State( m_burst, m_ticks_per_token ) ).first->second;
+}
+
+bool
+ChatRouter::accept_from( const Player& sender )
+{
+  State& state( state_of( sender ) );
+  if ( state.limiter.try_acquire() )
+  {
+    state.is_throttled = false;
+    return true;
+  }
+
+  thelog( yarrr::log::debug )( "Chat message dropped, rate limit reached by", sender.name );
+  //told once, until a message gets through again
+  if ( !state.is_throttled )
+  {
+    notify( sender, "You are sending messages too fast." );
+    state.is_throttled = true;
+  }
+  return false;
+}
+
+void
+ChatRouter::post( const Player& sender, const yarrr::ChatMessage& message )
+{
+  if ( !accept_from( sender ) )
+  {
+    return;
+  }
+
+  const State& state( state_of( sender ) );
+  if ( state.channel == party && state.party_name.empty() )
+  {
+    notify( sender, "You are not in a party. Use /party join <party name>." );
+    return;
+  }
+
+  m_pending_messages.push_back( PendingMessage{
+      state.channel,
+      sender.name,
+      state.party_name,
+      message.serialize() } );
+}
+
+void
+ChatRouter::whisper_to( const Player& sender, const std::string& recipient, const std::string& text )
+{
+  if ( !accept_from( sender ) )
+  {
+    return;
+  }
+
+  m_pending_messages.push_back( PendingMessage{
+      whisper,
+      sender.name,
+      recipient,
+      yarrr::ChatMessage( text, sender.name ).serialize() } );
+}
+
+bool
+ChatRouter::select_channel( const Player& player, const std::string& channel_name )
+{
+  State& state( state_of( player ) );
+  if ( channel_name == "global" )
+  {
+    state.channel = global;
+    return true;
+  }
+
+  if ( channel_name == "proximity" )
+  {
+    state.channel = proximity;
+    return true;
+  }
+
+  if ( channel_name == "party" )
+  {
+    state.channel = party;
+    return true;
+  }
+
+  return false;
+}
+
+void
+ChatRouter::join_party( const Player& player, const std::string& party_name )
+{
+  leave_party( player );
+  State& state( state_of( player ) );
+  state.party_name = party_name;
+  state.channel = party;
+  m_party_members[ party_name ].push_back( player.name );
+}
+
+void
+ChatRouter::leave_party( const Player& player )
+{
+  State& state( state_of( player ) );
+  if ( state.party_name.empty() )
+  {
+    return;
+  }
+
+  auto& members( m_party_members[ state.party_name ] );
+  members.erase( std::remove( std::begin( members ), std::end( members ), player.name ), std::end( members ) );
+  if ( members.empty() )
+  {
+    m_party_members.erase( state.party_name );
+  }
+
+  state.party_name.clear();
+  if ( state.channel == party )
+  {
+    state.channel = global;
+  }
+}
+
+void
+ChatRouter::forget( const std::string& player_name )
+{
+  const auto state( m_states.find( player_name ) );
+  if ( state == std::end( m_states ) )
+  {
+    return;
+  }
+
+  const std::string& party_name( state->second.party_name );
+  if ( !party_name.empty() )
+  {
+    auto& members( m_party_members[ party_name ] );
+    members.erase( std::remove( std::begin( members ), std::end( members ), player_name ), std::end( members ) );
+    if ( members.empty() )
+    {
+      m_party_members.erase( party_name );
+    }
+  }
+
+  m_states.erase( state );
+}
+
+ChatRouter::Grid
+ChatRouter::build_proximity_grid() const
+{
+  Grid grid;
+  for ( const auto& player : m_players )
+  {
+    yarrr::Coordinate position;
+    if ( position_of_player( *player.second, m_objects, position ) )
+    {
+      grid[ Cell(
+          cell_index_of( position.x, m_proximity_radius ),
+          cell_index_of( position.y, m_proximity_radius ) ) ].push_back( player.second->name );
+    }
+  }
+
+  return grid;
+}
+
+std::vector< Player* >
+ChatRouter::members_of( const std::string& party_name, const PlayersByName& players_by_name ) const
+{
+  std::vector< Player* > members;
+  const auto party( m_party_members.find( party_name ) );
+  if ( party == std::end( m_party_members ) )
+  {
+    return members;
+  }
+
+  for ( const auto& name : party->second )
+  {
+    const auto player( players_by_name.find( name ) );
+    if ( player != std::end( players_by_name ) )
+    {
+      members.push_back( player->second );
+    }
+  }
+
+  return members;
+}
+
+std::vector< Player* >
+ChatRouter::players_near(
+    const std::string& sender_name,
+    const PlayersByName& players_by_name,
+    const Grid& grid ) const
+{
+  std::vector< Player* > nearby_players;
+  const auto sender( players_by_name.find( sender_name ) );
+  if ( sender == std::end( players_by_name ) )
+  {
+    return nearby_players;
+  }
+
+  yarrr::Coordinate sender_position;
+  if ( !position_of_player( *sender->second, m_objects, sender_position ) )
+  {
+    nearby_players.push_back( sender->second );
+    return nearby_players;
+  }
+
+  const int64_t cell_x( cell_index_of( sender_position.x, m_proximity_radius ) );
+  const int64_t cell_y( cell_index_of( sender_position.y, m_proximity_radius ) );
+  for ( int64_t x( cell_x - 1 ); x <= cell_x + 1; ++x )
+  {
+    for ( int64_t y( cell_y - 1 ); y <= cell_y + 1; ++y )
+    {
+      const auto cell( grid.find( Cell( x, y ) ) );
+      if ( cell == std::end( grid ) )
+      {
+        continue;
+      }
+
+      for ( const auto& name : cell->second )
+      {
+        Player* const player( players_by_name.at( name ) );
+        yarrr::Coordinate position;
+        if ( position_of_player( *player, m_objects, position ) &&
+             is_within( sender_position, position, m_proximity_radius ) )
+        {
+          nearby_players.push_back( player );
+        }
+      }
+    }
+  }
+
+  return nearby_players;
+}
+
+void
+ChatRouter::flush()
+{
+  for ( auto& state : m_states )
+  {
+    state.second.limiter.tick();
+  }
+
+  if ( m_pending_messages.empty() )
+  {
+    return;
+  }
+
+  PlayersByName players_by_name;
+  for ( const auto& player : m_players )
+  {
+    players_by_name.emplace( player.second->name, player.second.get() );
+  }
+
+  const bool is_proximity_needed( std::any_of(
+        std::begin( m_pending_messages ), std::end( m_pending_messages ),
+        []( const PendingMessage& pending ) { return pending.channel == proximity; } ) );
+  const Grid grid( is_proximity_needed ? build_proximity_grid() : Grid() );
+
+  for ( auto& pending : m_pending_messages )
+  {
+    switch ( pending.channel )
+    {
+      case global:
+        broadcast( m_players, std::move( pending.message ) );
+        break;
+
+      case party:
+        send_to( members_of( pending.target, players_by_name ), std::move( pending.message ) );
+        break;
+
+      case proximity:
+        send_to( players_near( pending.sender_name, players_by_name, grid ), std::move( pending.message ) );
+        break;
+
+      case whisper:
+        {
+          const auto recipient( players_by_name.find( pending.target ) );
+          const auto sender( players_by_name.find( pending.sender_name ) );
+          std::vector< Player* > recipients;
+          if ( recipient != std::end( players_by_name ) )
+          {
+            recipients.push_back( recipient->second );
+          }
+          else if ( sender != std::end( players_by_name ) )
+          {
+            notify( *sender->second, "Unknown player: " + pending.target );
+          }
+
+          if ( sender != std::end( players_by_name ) && sender != recipient )
+          {
+            recipients.push_back( sender->second );
+          }
+
+          send_to( recipients, std::move( pending.message ) );
+        }
+        break;
+    }
+  }
+
+  m_pending_messages.clear();
+}
+
+}
+
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "player.hpp"
+#include "rate_limiter.hpp"
+#include <thectci/id.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace yarrr
+{
+
+class ChatMessage;
+class ObjectContainer;
+
+}
+
+namespace yarrrs
+{
+
+class ChatPosted
+{
+  public:
+    add_ctci( "chat_posted" );
+    ChatPosted( Player& sender, const yarrr::ChatMessage& message )
+      : sender( sender )
+      , message( message )
+    {
+    }
+
+    Player& sender;
+    const yarrr::ChatMessage& message;
+};
+
+//Routes chat messages to the players of a channel.  Messages are collected
+//during the tick and sent out by flush, each of them serialized only once.
+class ChatRouter
+{
+  public:
+    enum Channel
+    {
+      global,
+      proximity,
+      party,
+      whisper
+    };
+
+    ChatRouter( const Player::Container&, yarrr::ObjectContainer& );
+
+    void post( const Player& sender, const yarrr::ChatMessage& );
+    void whisper_to( const Player& sender, const std::string& recipient, const std::string& text );
+
+    bool select_channel( const Player&, const std::string& channel_name );
+    void join_party( const Player&, const std::string& party_name );
+    void leave_party( const Player& );
+    void forget( const std::string& player_name );
+
+    void flush();
+
+  private:
+    class State
+    {
+      public:
+        State( int burst, int ticks_per_token );
+
+        Channel channel;
+        std::string party_name;
+        RateLimiter limiter;
+        bool is_throttled;
+    };
+
+    class PendingMessage
+    {
+      public:
+        Channel channel;
+        std::string sender_name;
+        std::string target;
+        yarrr::Data message;
+    };
+
+    using PlayersByName = std::unordered_map< std::string, Player* >;
+    using Cell = std::pair< int64_t, int64_t >;
+    class CellHash
+    {
+      public:
+        size_t operator()( const Cell& cell ) const;
+    };
+    using Grid = std::unordered_map< Cell, std::vector< std::string >, CellHash >;
+
+    State& state_of( const Player& );
+    bool accept_from( const Player& sender );
+    Grid build_proximity_grid() const;
+
+    std::vector< Player* > members_of( const std::string& party_name, const PlayersByName& ) const;
+    std::vector< Player* > players_near( const std::string& sender_name, const PlayersByName&, const Grid& ) const;
+
+    const Player::Container& m_players;
+    yarrr::ObjectContainer& m_objects;
+    const int m_burst;
+    const int m_ticks_per_token;
+    const int64_t m_proximity_radius;
+
+    std::unordered_map< std::string, State > m_states;
+    std::unordered_map< std::string, std::vector< std::string > > m_party_members;
+    std::vector< PendingMessage > m_pending_messages;
+};
+
+}
+
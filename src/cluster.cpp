@@ -0,0 +1,316 @@
+#include "cluster.hpp"
+#include "capabilities.hpp"
+#include "configuration.hpp"
+#include "object_position.hpp"
+
+#include <yarrr/object_container.hpp>
+#include <yarrr/chat_message.hpp>
+#include <yarrr/command.hpp>
+#include <yarrr/log.hpp>
+#include <thectci/service_registry.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+
+std::string
+node_key( const std::string& node_id )
+{
+  return "cluster:node:" + node_id;
+}
+
+std::string
+player_key( const std::string& name )
+{
+  return "cluster:player:" + name;
+}
+
+std::string
+handoff_key( const std::string& name )
+{
+  return "cluster:handoff:" + name;
+}
+
+std::string
+zone_key( const yarrrs::Zones::Key& zone )
+{
+  return "cluster:zone:" + std::to_string( zone.first ) + ":" + std::to_string( zone.second );
+}
+
+std::string
+serialize_ship( const yarrr::PhysicalParameters& ship )
+{
+  std::stringstream serialized;
+  serialized <<
+    ship.coordinate.x << " " << ship.coordinate.y << " " <<
+    ship.velocity.x << " " << ship.velocity.y << " " <<
+    ship.orientation << " " << ship.angular_velocity;
+  return serialized.str();
+}
+
+bool
+deserialize_ship( const std::string& serialized, yarrr::PhysicalParameters& ship )
+{
+  std::stringstream stream( serialized );
+  yarrr::PhysicalParameters parsed( ship );
+  stream >>
+    parsed.coordinate.x >> parsed.coordinate.y >>
+    parsed.velocity.x >> parsed.velocity.y >>
+    parsed.orientation >> parsed.angular_velocity;
+  if ( stream.fail() )
+  {
+    return false;
+  }
+
+  ship = parsed;
+  return true;
+}
+
+class ShipInZone
+{
+  public:
+    int connection_id;
+    const yarrrs::Player& player;
+    const yarrr::PhysicalParameters& ship;
+    yarrrs::Zones::Key zone;
+};
+
+}
+
+namespace yarrrs
+{
+
+//Tells a client to log in again on the node at the address in its single
+//parameter, sent to clients with the capability of the same name.
+const std::string
+Cluster::handoff_command( "handoff" );
+
+Cluster::Configuration
+Cluster::Configuration::from_configuration()
+{
+  return Configuration{
+    configured_or< std::string >( "cluster_node_id", "" ),
+    configured_or< std::string >( "cluster_address",
+        "127.0.0.1:" + std::to_string( configured_or< int >( "port", 0 ) ) ),
+    std::max< int64_t >( 1, configured_or< int64_t >( "cluster_lease_milliseconds", 3000 ) ),
+    std::max( 1, configured_or< int >( "cluster_renew_interval", 10 ) ) };
+}
+
+std::vector< bool >
+Cluster::Store::acquire_all( const std::vector< std::string >& keys, const std::string& owner, int64_t lease_milliseconds )
+{
+  std::vector< bool > acquired;
+  for ( const auto& key : keys )
+  {
+    acquired.push_back( acquire( key, owner, lease_milliseconds ) );
+  }
+
+  return acquired;
+}
+
+Cluster::Cluster( Store& store, const Configuration& configuration )
+  : m_store( store )
+  , m_configuration( configuration )
+  , m_ticks( 0 )
+  , m_owned_zones( the::ctci::service< Metrics >().gauge(
+        "yarrr_cluster_zones_owned", "Zones leased by this node." ) )
+  , m_handoffs( the::ctci::service< Metrics >().counter(
+        "yarrr_cluster_handoffs_total", "Players handed off to another node." ) )
+{
+  thelog( yarrr::log::info )( "Joining cluster as", m_configuration.node_id, "at", m_configuration.address );
+}
+
+bool
+Cluster::claim_player( const std::string& name )
+{
+  if ( !m_store.acquire( player_key( name ), m_configuration.node_id, m_configuration.lease_milliseconds ) )
+  {
+    return false;
+  }
+
+  m_players.insert( name );
+  return true;
+}
+
+std::string
+Cluster::refusal_of( const std::string& name )
+{
+  std::string node_id;
+  std::string address;
+  if ( m_store.get( player_key( name ), node_id ) && m_store.get( node_key( node_id ), address ) )
+  {
+    return name + " is logged in on " + address + " already.";
+  }
+
+  return name + " is logged in on another server already.";
+}
+
+void
+Cluster::release_player( const std::string& name )
+{
+  if ( m_players.erase( name ) > 0 )
+  {
+    m_store.release( player_key( name ), m_configuration.node_id );
+  }
+}
+
+bool
+Cluster::take_handed_off_ship( const std::string& name, yarrr::PhysicalParameters& ship )
+{
+  std::string serialized;
+  return
+    m_store.take( handoff_key( name ), serialized ) &&
+    deserialize_ship( serialized, ship );
+}
+
+std::vector< int >
+Cluster::tick( Player::Container& players, const yarrr::ObjectContainer& objects, const Zones* zones )
+{
+  std::vector< int > dropped_players;
+  if ( ++m_ticks % m_configuration.renew_interval != 0 )
+  {
+    return dropped_players;
+  }
+
+  m_store.put( node_key( m_configuration.node_id ), m_configuration.address, m_configuration.lease_milliseconds );
+  const std::vector< std::string > names( std::begin( m_players ), std::end( m_players ) );
+  std::vector< std::string > keys;
+  for ( const auto& name : names )
+  {
+    keys.push_back( player_key( name ) );
+  }
+
+  const std::vector< bool > renewed( m_store.acquire_all( keys, m_configuration.node_id, m_configuration.lease_milliseconds ) );
+  std::set< std::string > lost_players;
+  for ( size_t i( 0 ); i < names.size(); ++i )
+  {
+    std::string owner;
+    //a store that failed to answer took the lease of nobody
+    if ( !renewed[ i ] && m_store.get( keys[ i ], owner ) && owner != m_configuration.node_id )
+    {
+      thelog( yarrr::log::warning )( "Lease of player lost to another node:", names[ i ], owner );
+      lost_players.insert( names[ i ] );
+      m_players.erase( names[ i ] );
+    }
+  }
+
+  for ( const auto& player : players )
+  {
+    if ( lost_players.count( player.second->name ) > 0 )
+    {
+      player.second->send( yarrr::ChatMessage( "You logged in on another server, logging out here.", "server" ).serialize() );
+      dropped_players.push_back( player.first );
+    }
+  }
+
+  if ( !zones )
+  {
+    return dropped_players;
+  }
+
+  std::vector< ShipInZone > ships;
+  std::set< Zones::Key > zones_of_ships;
+  for ( const auto& player : players )
+  {
+    const yarrr::PhysicalParameters* const ship(
+        player.second->has_object() ?
+        physical_parameters_of( objects, player.second->object_id() ) :
+        nullptr );
+    if ( !ship || lost_players.count( player.second->name ) > 0 )
+    {
+      continue;
+    }
+
+    ships.push_back( ShipInZone{ player.first, *player.second, *ship, zones->zone_of( ship->coordinate ) } );
+    zones_of_ships.insert( ships.back().zone );
+  }
+
+  const std::map< Zones::Key, std::string > owners( owners_of( zones_of_ships ) );
+  for ( const auto& ship : ships )
+  {
+    const std::string& owner( owners.at( ship.zone ) );
+    if ( owner != m_configuration.node_id && hand_off( ship.player, ship.ship, owner ) )
+    {
+      dropped_players.push_back( ship.connection_id );
+    }
+  }
+
+  for ( const auto& zone : m_zones )
+  {
+    const auto owner( owners.find( zone ) );
+    if ( owner == std::end( owners ) || owner->second != m_configuration.node_id )
+    {
+      m_store.release( zone_key( zone ), m_configuration.node_id );
+    }
+  }
+
+  m_zones.clear();
+  for ( const auto& owner : owners )
+  {
+    if ( owner.second == m_configuration.node_id )
+    {
+      m_zones.insert( owner.first );
+    }
+  }
+
+  m_owned_zones.set( m_zones.size() );
+  return dropped_players;
+}
+
+std::map< Zones::Key, std::string >
+Cluster::owners_of( const std::set< Zones::Key >& zones )
+{
+  const std::vector< Zones::Key > ordered_zones( std::begin( zones ), std::end( zones ) );
+  std::vector< std::string > keys;
+  for ( const auto& zone : ordered_zones )
+  {
+    keys.push_back( zone_key( zone ) );
+  }
+
+  const std::vector< bool > acquired( m_store.acquire_all( keys, m_configuration.node_id, m_configuration.lease_milliseconds ) );
+  std::map< Zones::Key, std::string > owners;
+  for ( size_t i( 0 ); i < ordered_zones.size(); ++i )
+  {
+    std::string owner;
+    if ( acquired[ i ] || !m_store.get( keys[ i ], owner ) )
+    {
+      //the lease may have just expired, the zone is taken at the next renewal then
+      owner = m_configuration.node_id;
+    }
+
+    owners.emplace( ordered_zones[ i ], owner );
+  }
+
+  return owners;
+}
+
+bool
+Cluster::hand_off( const Player& player, const yarrr::PhysicalParameters& ship, const std::string& node_id )
+{
+  std::string address;
+  if ( !m_store.get( node_key( node_id ), address ) )
+  {
+    thelog( yarrr::log::warning )( "Zone owner has no address, keeping player:", player.name, node_id );
+    return false;
+  }
+
+  thelog( yarrr::log::info )( "Handing off player", player.name, "to", node_id, address );
+  m_store.put( handoff_key( player.name ), serialize_ship( ship ), m_configuration.lease_milliseconds );
+  release_player( player.name );
+  if ( player.has_capability( Capabilities::cluster_handoff ) )
+  {
+    player.send( yarrr::Command( { handoff_command, address } ).serialize() );
+  }
+  else
+  {
+    player.send( yarrr::ChatMessage( "This part of space is served by " + address + ", log in there.", "server" ).serialize() );
+  }
+
+  m_handoffs.increment();
+  return true;
+}
+
+}
+
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "player.hpp"
+#include "metrics.hpp"
+#include "zones.hpp"
+#include <yarrr/basic_behaviors.hpp>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace yarrr
+{
+
+class ObjectContainer;
+
+}
+
+namespace yarrrs
+{
+
+//Lets several servers share one universe through a common store.  Every node
+//holds leases on the players logged in to it and on the zones its players are
+//in, and renews them periodically; the leases of a node that goes away expire.
+//A player whose ship crosses into a zone of another node is handed off: its
+//ship is parked in the store, and the client is told where to log in again.
+class Cluster
+{
+  public:
+    static const std::string handoff_command;
+
+    //The shared store of the leases, Redis in production.
+    class Store
+    {
+      public:
+        virtual ~Store() = default;
+
+        //takes a free key or renews one held by the same owner already
+        virtual bool acquire( const std::string& key, const std::string& owner, int64_t lease_milliseconds ) = 0;
+        //acquires every key, in one round trip where the store can, and
+        //returns the results in the order of the keys
+        virtual std::vector< bool > acquire_all(
+            const std::vector< std::string >& keys, const std::string& owner, int64_t lease_milliseconds );
+        virtual void release( const std::string& key, const std::string& owner ) = 0;
+        virtual bool get( const std::string& key, std::string& value ) = 0;
+        virtual void put( const std::string& key, const std::string& value, int64_t lease_milliseconds ) = 0;
+        //gets and deletes the key
+        virtual bool take( const std::string& key, std::string& value ) = 0;
+    };
+
+    class Configuration
+    {
+      public:
+        //an empty node id means the server runs alone
+        static Configuration from_configuration();
+
+        std::string node_id;
+        //where the clients of this node connect to, host:port
+        std::string address;
+        int64_t lease_milliseconds;
+        int renew_interval;
+    };
+
+    Cluster( Store&, const Configuration& );
+
+    //false when the player is logged in on another node
+    bool claim_player( const std::string& name );
+    //tells the client refused by claim_player where the player is logged in
+    std::string refusal_of( const std::string& name );
+    void release_player( const std::string& name );
+    bool take_handed_off_ship( const std::string& name, yarrr::PhysicalParameters& );
+
+    //renews the leases once in every renew interval and returns the connection
+    //ids of the players to disconnect: the ones handed off to other nodes and
+    //the ones whose lease another node took
+    std::vector< int > tick( Player::Container&, const yarrr::ObjectContainer&, const Zones* );
+
+  private:
+    std::map< Zones::Key, std::string > owners_of( const std::set< Zones::Key >& );
+    bool hand_off( const Player&, const yarrr::PhysicalParameters&, const std::string& node_id );
+
+    Store& m_store;
+    const Configuration m_configuration;
+    int64_t m_ticks;
+    std::set< std::string > m_players;
+    std::set< Zones::Key > m_zones;
+    Metrics::Value& m_owned_zones;
+    Metrics::Value& m_handoffs;
+};
+
+}
+
@@ -3,28 +3,96 @@
 #include <yarrr/command.hpp>
 #include <yarrr/log.hpp>
 
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+
+bool
+is_less( const std::pair< std::string, size_t >& interned, const std::string& command )
+{
+  return interned.first < command;
+}
+
+}
+
 namespace yarrrs
 {
 
+CommandHandler::Result::Result( bool did_succeed, std::string message )
+  : m_did_succeed( did_succeed )
+  , m_message( std::move( message ) )
+{
+}
+
+CommandHandler::Result
+CommandHandler::Result::success()
+{
+  return Result( true, std::string() );
+}
+
+CommandHandler::Result
+CommandHandler::Result::failure( std::string message )
+{
+  return Result( false, std::move( message ) );
+}
+
+bool
+CommandHandler::Result::did_succeed() const
+{
+  return m_did_succeed;
+}
+
+const std::string&
+CommandHandler::Result::message() const
+{
+  return m_message;
+}
+
+const CommandHandler::Id
+CommandHandler::unknown( std::numeric_limits< CommandHandler::Id >::max() );
+
+CommandHandler::Id
+CommandHandler::id_of( const std::string& command ) const
+{
+  const auto interned( std::lower_bound( std::begin( m_ids ), std::end( m_ids ), command, is_less ) );
+  if ( interned == std::end( m_ids ) || interned->first != command )
+  {
+    return unknown;
+  }
+
+  return interned->second;
+}
+
 CommandHandler::Result
 CommandHandler::execute( const yarrr::Command& command, Player& player ) const
 {
   thelog( yarrr::log::debug )( "Looking for command executor for", command.command(), &player );
 
-  const auto handler( m_handlers.find( command.command() ) );
-  if ( handler == m_handlers.end() )
+  const Id id( id_of( command.command() ) );
+  if ( id == unknown )
   {
-    return Result( false, "Unknown command:" + command.command() );
+    return Result::failure( "Unknown command:" + command.command() );
   }
 
-  return handler->second( command, player );
+  return m_handlers[ id ]( command, player );
 }
 
 void
 CommandHandler::register_handler( const std::string& command, Handler handler )
 {
   thelog( yarrr::log::debug )( "Registering command executor for", command );
-  m_handlers[ command ] = handler;
+  const Id id( id_of( command ) );
+  if ( id != unknown )
+  {
+    m_handlers[ id ] = handler;
+    return;
+  }
+
+  const auto position( std::lower_bound( std::begin( m_ids ), std::end( m_ids ), command, is_less ) );
+  m_ids.emplace( position, command, m_handlers.size() );
+  m_handlers.emplace_back( std::move( handler ) );
 }
 
 }
@@ -2,7 +2,7 @@
 
 #include <string>
 #include <functional>
-#include <unordered_map>
+#include <vector>
 
 namespace yarrr
 {
@@ -20,14 +20,35 @@ class Player;
 class CommandHandler
 {
   public:
-    typedef std::tuple< bool, std::string > Result;
+    class Result
+    {
+      public:
+        static Result success();
+        static Result failure( std::string message );
+
+        bool did_succeed() const;
+        const std::string& message() const;
+
+      private:
+        Result( bool did_succeed, std::string message );
+
+        bool m_did_succeed;
+        std::string m_message;
+    };
+
     Result execute( const yarrr::Command&, Player& ) const;
 
     typedef std::function< Result( const yarrr::Command&, Player& ) > Handler;
     void register_handler( const std::string& command, Handler handler );
 
   private:
-    std::unordered_map< std::string, Handler > m_handlers;
+    using Id = size_t;
+    static const Id unknown;
+    Id id_of( const std::string& command ) const;
+
+    //command names are interned to indices of m_handlers, sorted by name for lookup
+    std::vector< std::pair< std::string, Id > > m_ids;
+    std::vector< Handler > m_handlers;
 
 };
 
@@ -0,0 +1,205 @@
+#include "compact_physics.hpp"
+#include "configuration.hpp"
+#include "varint.hpp"
+
+#include <yarrr/command.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+const int64_t steps_per_sector( 65536 );
+const uint8_t has_velocity( 1 );
+const uint8_t has_angular_velocity( 2 );
+
+int64_t
+floor_divide( int64_t value, int64_t divisor )
+{
+  return value >= 0 ?
+    value / divisor :
+    ( value - divisor + 1 ) / divisor;
+}
+
+int64_t
+rounded_divide( int64_t value, int64_t divisor )
+{
+  return int64_t( std::llround( double( value ) / divisor ) );
+}
+
+void
+write_uint16( yarrr::Data& output, uint16_t value )
+{
+  output.push_back( static_cast< char >( value & 0xff ) );
+  output.push_back( static_cast< char >( value >> 8 ) );
+}
+
+bool
+read_uint16( const yarrr::Data& input, size_t& position, uint16_t& value )
+{
+  if ( position + 2 > input.size() )
+  {
+    return false;
+  }
+
+  value = uint16_t( uint8_t( input[ position ] ) | ( uint8_t( input[ position + 1 ] ) << 8 ) );
+  position += 2;
+  return true;
+}
+
+bool
+read_signed( const yarrr::Data& input, size_t& position, int64_t& value )
+{
+  uint64_t encoded( 0 );
+  if ( !yarrrs::read_varint( input, position, encoded ) )
+  {
+    return false;
+  }
+
+  value = yarrrs::unzigzag( encoded );
+  return true;
+}
+
+}
+
+namespace yarrrs
+{
+
+const std::string
+CompactPhysics::message_name( "compact_physics" );
+
+CompactPhysics::Quantization
+CompactPhysics::Quantization::from_configuration()
+{
+  return Quantization{
+    std::max< int64_t >( 1, configured_or< int64_t >( "compact_position_step", 16 ) ),
+    std::max< int64_t >( 1, configured_or< int64_t >( "compact_velocity_step", 4 ) ),
+    std::max< yarrr::Angle >( 1, configured_or< yarrr::Angle >( "compact_angle_per_turn", 1440 ) ) };
+}
+
+CompactPhysics::CompactPhysics( const Quantization& quantization )
+  : m_quantization( quantization )
+{
+}
+
+void
+CompactPhysics::encode_payload(
+    yarrr::Data& payload,
+    yarrr::Object::Id id,
+    const yarrr::PhysicalParameters& physical_parameters ) const
+{
+  const int64_t step( m_quantization.position_step );
+  const int64_t x( rounded_divide( physical_parameters.coordinate.x, step ) );
+  const int64_t y( rounded_divide( physical_parameters.coordinate.y, step ) );
+  const int64_t sector_x( floor_divide( x, steps_per_sector ) );
+  const int64_t sector_y( floor_divide( y, steps_per_sector ) );
+
+  const int64_t velocity_x( rounded_divide( physical_parameters.velocity.x, m_quantization.velocity_step ) );
+  const int64_t velocity_y( rounded_divide( physical_parameters.velocity.y, m_quantization.velocity_step ) );
+  const uint8_t flags(
+      ( velocity_x || velocity_y ? has_velocity : 0 ) |
+      ( physical_parameters.angular_velocity ? has_angular_velocity : 0 ) );
+
+  const int64_t turn( m_quantization.angle_per_turn );
+  const int64_t orientation( ( int64_t( physical_parameters.orientation ) % turn + turn ) % turn );
+
+  write_varint( payload, id );
+  write_varint( payload, uint64_t( physical_parameters.timestamp ) );
+  payload.push_back( static_cast< char >( flags ) );
+  write_varint( payload, zigzag( sector_x ) );
+  write_varint( payload, zigzag( sector_y ) );
+  write_uint16( payload, uint16_t( x - sector_x * steps_per_sector ) );
+  write_uint16( payload, uint16_t( y - sector_y * steps_per_sector ) );
+  write_uint16( payload, uint16_t( rounded_divide( orientation * 65536, turn ) ) );
+
+  if ( flags & has_velocity )
+  {
+    write_varint( payload, zigzag( velocity_x ) );
+    write_varint( payload, zigzag( velocity_y ) );
+  }
+
+  if ( flags & has_angular_velocity )
+  {
+    write_varint( payload, zigzag( physical_parameters.angular_velocity ) );
+  }
+
+  write_varint( payload, zigzag( physical_parameters.integrity ) );
+}
+
+yarrr::Data
+CompactPhysics::encode( yarrr::Object::Id id, const yarrr::PhysicalParameters& physical_parameters ) const
+{
+  yarrr::Data payload;
+  payload.reserve( 32 );
+  encode_payload( payload, id, physical_parameters );
+  return yarrr::Command( {
+      message_name,
+      std::string( std::begin( payload ), std::end( payload ) ) } ).serialize();
+}
+
+bool
+CompactPhysics::decode(
+    const std::string& payload_string,
+    yarrr::Object::Id& id,
+    yarrr::PhysicalParameters& physical_parameters ) const
+{
+  const yarrr::Data payload( std::begin( payload_string ), std::end( payload_string ) );
+  size_t position( 0 );
+  uint64_t timestamp( 0 );
+  if ( !read_varint( payload, position, id ) ||
+       !read_varint( payload, position, timestamp ) ||
+       position >= payload.size() )
+  {
+    return false;
+  }
+
+  const uint8_t flags( payload[ position++ ] );
+  int64_t sector_x( 0 );
+  int64_t sector_y( 0 );
+  uint16_t offset_x( 0 );
+  uint16_t offset_y( 0 );
+  uint16_t orientation( 0 );
+  if ( !read_signed( payload, position, sector_x ) ||
+       !read_signed( payload, position, sector_y ) ||
+       !read_uint16( payload, position, offset_x ) ||
+       !read_uint16( payload, position, offset_y ) ||
+       !read_uint16( payload, position, orientation ) )
+  {
+    return false;
+  }
+
+  int64_t velocity_x( 0 );
+  int64_t velocity_y( 0 );
+  if ( ( flags & has_velocity ) &&
+       ( !read_signed( payload, position, velocity_x ) || !read_signed( payload, position, velocity_y ) ) )
+  {
+    return false;
+  }
+
+  int64_t angular_velocity( 0 );
+  if ( ( flags & has_angular_velocity ) && !read_signed( payload, position, angular_velocity ) )
+  {
+    return false;
+  }
+
+  int64_t integrity( 0 );
+  if ( !read_signed( payload, position, integrity ) )
+  {
+    return false;
+  }
+
+  const int64_t step( m_quantization.position_step );
+  physical_parameters.coordinate.x = ( sector_x * steps_per_sector + offset_x ) * step;
+  physical_parameters.coordinate.y = ( sector_y * steps_per_sector + offset_y ) * step;
+  physical_parameters.velocity.x = velocity_x * m_quantization.velocity_step;
+  physical_parameters.velocity.y = velocity_y * m_quantization.velocity_step;
+  physical_parameters.orientation = yarrr::Angle( rounded_divide( orientation * m_quantization.angle_per_turn, 65536 ) );
+  physical_parameters.angular_velocity = yarrr::Angle( angular_velocity );
+  physical_parameters.integrity = integrity;
+  physical_parameters.timestamp = timestamp;
+  return true;
+}
+
+}
+
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <yarrr/object.hpp>
+#include <yarrr/basic_behaviors.hpp>
+#include <string>
+
+namespace yarrrs
+{
+
+//Packs the physical parameters of one object into a command named
+//compact_physics for clients with the capability of the same name.  The
+//single parameter of the command holds, in this order:
+//  varint object id, varint timestamp, flag byte,
+//  zigzag varint sector x and y, 16 bit offset x and y in the sector,
+//  16 bit orientation as a fraction of a full turn,
+//  zigzag varint velocity x and y if flag bit 0 is set,
+//  zigzag varint angular velocity if flag bit 1 is set,
+//  zigzag varint integrity.
+//A sector is 65536 position steps wide, velocities are counted in velocity
+//steps, the 16 bit values are little endian.
+class CompactPhysics
+{
+  public:
+    static const std::string message_name;
+
+    class Quantization
+    {
+      public:
+        static Quantization from_configuration();
+
+        int64_t position_step;
+        int64_t velocity_step;
+        yarrr::Angle angle_per_turn;
+    };
+
+    CompactPhysics( const Quantization& );
+
+    yarrr::Data encode( yarrr::Object::Id, const yarrr::PhysicalParameters& ) const;
+    bool decode( const std::string& payload, yarrr::Object::Id&, yarrr::PhysicalParameters& ) const;
+
+  private:
+    void encode_payload( yarrr::Data& payload, yarrr::Object::Id, const yarrr::PhysicalParameters& ) const;
+
+    const Quantization m_quantization;
+};
+
+}
+
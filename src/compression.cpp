@@ -0,0 +1,263 @@
+#include "compression.hpp"
+#include "configuration.hpp"
+#include "varint.hpp"
+
+#include <yarrr/command.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+const size_t min_match( 4 );
+const size_t max_offset( 65535 );
+const size_t hash_bits( 12 );
+const uint8_t nibble_max( 15 );
+const size_t max_decompressed_size( 64 * 1024 * 1024 );
+
+uint32_t
+read32( const yarrr::Data& data, size_t position )
+{
+  uint32_t value;
+  std::memcpy( &value, &data[ position ], sizeof( value ) );
+  return value;
+}
+
+size_t
+hash_of( uint32_t sequence )
+{
+  return ( sequence * 2654435761u ) >> ( 32 - hash_bits );
+}
+
+void
+write_extra_length( yarrr::Data& output, size_t length )
+{
+  if ( length < nibble_max )
+  {
+    return;
+  }
+
+  length -= nibble_max;
+  while ( length >= 255 )
+  {
+    output.push_back( static_cast< char >( 255 ) );
+    length -= 255;
+  }
+  output.push_back( static_cast< char >( length ) );
+}
+
+bool
+read_extra_length( const yarrr::Data& input, size_t& position, size_t& length )
+{
+  if ( length < nibble_max )
+  {
+    return true;
+  }
+
+  uint8_t byte( 255 );
+  while ( byte == 255 )
+  {
+    if ( position >= input.size() )
+    {
+      return false;
+    }
+
+    byte = input[ position++ ];
+    length += byte;
+  }
+
+  return true;
+}
+
+void
+write_sequence(
+    yarrr::Data& output,
+    const yarrr::Data& input,
+    size_t literal_start,
+    size_t literal_length,
+    size_t offset,
+    size_t match_length )
+{
+  const size_t match_code( match_length >= min_match ? match_length - min_match : 0 );
+  const uint8_t token(
+      ( std::min< size_t >( literal_length, nibble_max ) << 4 ) |
+      std::min< size_t >( match_code, nibble_max ) );
+  output.push_back( static_cast< char >( token ) );
+  write_extra_length( output, literal_length );
+  output.insert(
+      std::end( output ),
+      std::begin( input ) + literal_start,
+      std::begin( input ) + literal_start + literal_length );
+
+  if ( match_length < min_match )
+  {
+    return;
+  }
+
+  output.push_back( static_cast< char >( offset & 0xff ) );
+  output.push_back( static_cast< char >( offset >> 8 ) );
+  write_extra_length( output, match_code );
+}
+
+}
+
+namespace yarrrs
+{
+
+namespace lz
+{
+
+yarrr::Data
+compress( const yarrr::Data& input )
+{
+  const size_t size( input.size() );
+  yarrr::Data output;
+  output.reserve( size + size / 255 + 16 );
+  write_varint( output, size );
+
+  std::vector< size_t > last_position_plus_one( size_t( 1 ) << hash_bits, 0 );
+  size_t anchor( 0 );
+  size_t position( 0 );
+  while ( position + min_match <= size )
+  {
+    const uint32_t sequence( read32( input, position ) );
+    size_t& slot( last_position_plus_one[ hash_of( sequence ) ] );
+    const size_t candidate_plus_one( slot );
+    slot = position + 1;
+
+    const bool is_match(
+        candidate_plus_one > 0 &&
+        position - ( candidate_plus_one - 1 ) <= max_offset &&
+        read32( input, candidate_plus_one - 1 ) == sequence );
+
+    if ( !is_match )
+    {
+      ++position;
+      continue;
+    }
+
+    const size_t match_start( candidate_plus_one - 1 );
+    size_t match_length( min_match );
+    while ( position + match_length < size && input[ match_start + match_length ] == input[ position + match_length ] )
+    {
+      ++match_length;
+    }
+
+    write_sequence( output, input, anchor, position - anchor, position - match_start, match_length );
+    position += match_length;
+    anchor = position;
+  }
+
+  write_sequence( output, input, anchor, size - anchor, 0, 0 );
+  return output;
+}
+
+bool
+decompress( const yarrr::Data& input, yarrr::Data& output )
+{
+  size_t position( 0 );
+  uint64_t size( 0 );
+  if ( !read_varint( input, position, size ) || size > max_decompressed_size )
+  {
+    return false;
+  }
+
+  output.clear();
+  output.reserve( size );
+  while ( position < input.size() )
+  {
+    const uint8_t token( input[ position++ ] );
+    size_t literal_length( token >> 4 );
+    if ( !read_extra_length( input, position, literal_length ) ||
+         position + literal_length > input.size() ||
+         output.size() + literal_length > size )
+    {
+      return false;
+    }
+
+    output.insert(
+        std::end( output ),
+        std::begin( input ) + position,
+        std::begin( input ) + position + literal_length );
+    position += literal_length;
+
+    if ( output.size() == size )
+    {
+      return position == input.size();
+    }
+
+    if ( position + 2 > input.size() )
+    {
+      return false;
+    }
+
+    const size_t offset(
+        uint8_t( input[ position ] ) |
+        ( size_t( uint8_t( input[ position + 1 ] ) ) << 8 ) );
+    position += 2;
+
+    size_t match_length( token & nibble_max );
+    if ( !read_extra_length( input, position, match_length ) )
+    {
+      return false;
+    }
+    match_length += min_match;
+
+    if ( offset == 0 || offset > output.size() || output.size() + match_length > size )
+    {
+      return false;
+    }
+
+    //matches may overlap the bytes they produce, so copy one by one
+    size_t match_start( output.size() - offset );
+    for ( size_t i( 0 ); i < match_length; ++i )
+    {
+      output.push_back( output[ match_start + i ] );
+    }
+  }
+
+  return output.size() == size;
+}
+
+}
+
+const std::string
+Compressor::compressed_message( "compressed" );
+
+Compressor::Compressor( size_t threshold )
+  : m_threshold( threshold )
+{
+}
+
+size_t
+Compressor::threshold_from_configuration()
+{
+  return configured_or< size_t >( "compression_threshold", 256 );
+}
+
+yarrr::Data
+Compressor::compress_if_worth_it( yarrr::Data&& message ) const
+{
+  if ( message.size() < m_threshold )
+  {
+    return std::move( message );
+  }
+
+  const yarrr::Data compressed( lz::compress( message ) );
+  yarrr::Data wrapped( yarrr::Command( {
+        compressed_message,
+        std::string( std::begin( compressed ), std::end( compressed ) ) } ).serialize() );
+
+  if ( wrapped.size() >= message.size() )
+  {
+    return std::move( message );
+  }
+
+  return wrapped;
+}
+
+}
+
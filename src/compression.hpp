@@ -0,0 +1,35 @@
+#pragma once
+
+#include <yarrr/object.hpp>
+
+namespace yarrrs
+{
+
+//A small LZ77 codec for the larger messages sent to clients.
+//The stream starts with the uncompressed size as a varint, followed by sequences of
+//a token byte, extra literal length, literals, a two byte offset and extra match length.
+namespace lz
+{
+
+yarrr::Data compress( const yarrr::Data& input );
+bool decompress( const yarrr::Data& input, yarrr::Data& output );
+
+}
+
+//Wraps messages of at least threshold bytes into a compressed command when that
+//makes them smaller.
+class Compressor
+{
+  public:
+    static const std::string compressed_message;
+    static size_t threshold_from_configuration();
+
+    Compressor( size_t threshold );
+    yarrr::Data compress_if_worth_it( yarrr::Data&& message ) const;
+
+  private:
+    const size_t m_threshold;
+};
+
+}
+
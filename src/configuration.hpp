@@ -0,0 +1,19 @@
+#pragma once
+
+#include <theconf/configuration.hpp>
+#include <string>
+
+namespace yarrrs
+{
+
+template < typename T >
+T
+configured_or( const std::string& key, T fallback )
+{
+  return the::conf::has( key ) ?
+    the::conf::get< T >( key ) :
+    fallback;
+}
+
+}
+
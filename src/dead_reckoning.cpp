@@ -0,0 +1,100 @@
+#include "dead_reckoning.hpp"
+#include "configuration.hpp"
+
+#include <thetime/clock.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace yarrrs
+{
+
+DeadReckoning::Tolerances
+DeadReckoning::Tolerances::from_configuration()
+{
+  return Tolerances{
+    configured_or< int64_t >( "dead_reckoning_position_tolerance", 100 ),
+    configured_or< yarrr::Angle >( "dead_reckoning_angle_tolerance", 50 ),
+    std::max( 1, configured_or< int >( "dead_reckoning_keyframe_ticks", 30 ) ),
+    std::max< yarrr::Angle >( 1, configured_or< yarrr::Angle >( "compact_angle_per_turn", 1440 ) ) };
+}
+
+DeadReckoning::DeadReckoning( const Tolerances& tolerances )
+  : m_tolerances( tolerances )
+{
+}
+
+yarrr::PhysicalParameters
+DeadReckoning::extrapolate( const yarrr::PhysicalParameters& physical_parameters, int64_t timestamp )
+{
+  const int64_t elapsed( timestamp - physical_parameters.timestamp );
+  yarrr::PhysicalParameters extrapolated( physical_parameters );
+  extrapolated.coordinate.x += physical_parameters.velocity.x * elapsed / the::time::Clock::ticks_per_second;
+  extrapolated.coordinate.y += physical_parameters.velocity.y * elapsed / the::time::Clock::ticks_per_second;
+  extrapolated.orientation += physical_parameters.angular_velocity * elapsed / the::time::Clock::ticks_per_second;
+  extrapolated.timestamp = timestamp;
+  return extrapolated;
+}
+
+bool
+DeadReckoning::has_drifted( const Sent& sent, const yarrr::PhysicalParameters& current ) const
+{
+  if ( sent.physical_parameters.integrity != current.integrity )
+  {
+    return true;
+  }
+
+  const yarrr::PhysicalParameters predicted( extrapolate( sent.physical_parameters, current.timestamp ) );
+  const double dx( double( predicted.coordinate.x ) - double( current.coordinate.x ) );
+  const double dy( double( predicted.coordinate.y ) - double( current.coordinate.y ) );
+  const double position_tolerance( double( m_tolerances.position ) );
+  if ( dx * dx + dy * dy > position_tolerance * position_tolerance )
+  {
+    return true;
+  }
+
+  const double turn( m_tolerances.angle_per_turn );
+  const double turned( std::abs( std::fmod( double( predicted.orientation ) - double( current.orientation ), turn ) ) );
+  return std::min( turned, turn - turned ) > double( m_tolerances.orientation );
+}
+
+DeadReckoning::Update
+DeadReckoning::update_needed( yarrr::Object::Id id, const yarrr::PhysicalParameters& current, int64_t tick )
+{
+  const auto sent( m_sent.find( id ) );
+  if ( sent == std::end( m_sent ) )
+  {
+    m_sent.emplace( id, Sent{ current, tick } );
+    return keyframe;
+  }
+
+  const bool is_keyframe_due( tick - sent->second.tick >= m_tolerances.keyframe_ticks );
+  if ( !is_keyframe_due && !has_drifted( sent->second, current ) )
+  {
+    return not_needed;
+  }
+
+  sent->second = Sent{ current, tick };
+  return is_keyframe_due ? keyframe : correction;
+}
+
+bool
+DeadReckoning::is_update_needed( yarrr::Object::Id id, const yarrr::PhysicalParameters& current, int64_t tick )
+{
+  return update_needed( id, current, tick ) != not_needed;
+}
+
+void
+DeadReckoning::forget( yarrr::Object::Id id )
+{
+  m_sent.erase( id );
+}
+
+void
+DeadReckoning::forget_all()
+{
+  m_sent.clear();
+}
+
+}
+
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <yarrr/object.hpp>
+#include <yarrr/basic_behaviors.hpp>
+#include <unordered_map>
+
+namespace yarrrs
+{
+
+//Follows what one client believes about the objects it was sent.  Between two
+//updates the client moves an object along its velocity and turns it with its
+//angular velocity, so a new update is needed only when the real state drifted
+//from that extrapolation beyond the tolerances, when the integrity changed, or
+//when the last update is older than the keyframe interval.
+class DeadReckoning
+{
+  public:
+    class Tolerances
+    {
+      public:
+        static Tolerances from_configuration();
+
+        int64_t position;
+        yarrr::Angle orientation;
+        int keyframe_ticks;
+        //the orientation of a full turn, differences are taken around it
+        yarrr::Angle angle_per_turn;
+    };
+
+    enum Update
+    {
+      not_needed,
+      correction,
+      keyframe
+    };
+
+    DeadReckoning( const Tolerances& );
+
+    //Any update needed counts as sent in the given tick.  The first update of
+    //an object and the periodic ones are keyframes.
+    Update update_needed( yarrr::Object::Id, const yarrr::PhysicalParameters&, int64_t tick );
+    bool is_update_needed( yarrr::Object::Id, const yarrr::PhysicalParameters&, int64_t tick );
+    void forget( yarrr::Object::Id );
+    void forget_all();
+
+    static yarrr::PhysicalParameters extrapolate( const yarrr::PhysicalParameters&, int64_t timestamp );
+
+  private:
+    class Sent
+    {
+      public:
+        yarrr::PhysicalParameters physical_parameters;
+        int64_t tick;
+    };
+
+    bool has_drifted( const Sent&, const yarrr::PhysicalParameters& ) const;
+
+    const Tolerances m_tolerances;
+    std::unordered_map< yarrr::Object::Id, Sent > m_sent;
+};
+
+}
+
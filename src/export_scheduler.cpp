@@ -0,0 +1,48 @@
+#include "export_scheduler.hpp"
+#include "configuration.hpp"
+
+#include <thectci/service_registry.hpp>
+#include <algorithm>
+
+namespace yarrrs
+{
+
+int64_t
+ExportScheduler::interval_from_configuration()
+{
+  return configured_or< int64_t >( "object_export_interval", 5 );
+}
+
+ExportScheduler::ExportScheduler( Refresh refresh, int64_t interval_in_ticks )
+  : m_refresh( std::move( refresh ) )
+  , m_interval( std::max< int64_t >( 1, interval_in_ticks ) )
+  , m_tick( 0 )
+  , m_refreshed_at( 0 )
+  , m_is_refreshed( false )
+  , m_refreshes( the::ctci::service< Metrics >().counter(
+        "yarrr_object_exports_total", "Refreshes of the objects exported into the lua model." ) )
+{
+}
+
+void
+ExportScheduler::tick()
+{
+  ++m_tick;
+}
+
+void
+ExportScheduler::before_reading()
+{
+  if ( m_is_refreshed && m_tick - m_refreshed_at < m_interval )
+  {
+    return;
+  }
+
+  m_refresh();
+  m_refreshed_at = m_tick;
+  m_is_refreshed = true;
+  m_refreshes.increment();
+}
+
+}
+
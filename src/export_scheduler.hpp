@@ -0,0 +1,38 @@
+#pragma once
+
+#include "metrics.hpp"
+#include <cstdint>
+#include <functional>
+
+namespace yarrrs
+{
+
+//Refreshes an export of the objects into the lua model only when lua code is
+//about to read it, and at most once in an interval.  Exporting every object
+//is a large share of a tick, while most ticks nobody reads the export: the
+//mission updates run for a slice of the players only, and the remote readers
+//ask for a snapshot now and then.
+class ExportScheduler
+{
+  public:
+    using Refresh = std::function< void() >;
+
+    static int64_t interval_from_configuration();
+
+    ExportScheduler( Refresh, int64_t interval_in_ticks );
+
+    void tick();
+    //refreshes when the export is older than the interval
+    void before_reading();
+
+  private:
+    const Refresh m_refresh;
+    const int64_t m_interval;
+    int64_t m_tick;
+    int64_t m_refreshed_at;
+    bool m_is_refreshed;
+    Metrics::Value& m_refreshes;
+};
+
+}
+
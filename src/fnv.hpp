@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace yarrrs
+{
+
+//64 bit FNV-1a, pass the previous hash to continue hashing.
+const uint64_t fnv_offset_basis( 14695981039346656037ull );
+
+inline uint64_t
+fnv1a( const char* data, size_t size, uint64_t hash = fnv_offset_basis )
+{
+  for ( size_t i( 0 ); i < size; ++i )
+  {
+    hash ^= static_cast< unsigned char >( data[ i ] );
+    hash *= 1099511628211ull;
+  }
+
+  return hash;
+}
+
+}
+
@@ -0,0 +1,260 @@
+#include "json.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+
+bool
+is_whitespace( char character )
+{
+  return character == ' ' || character == '\t' || character == '\n' || character == '\r';
+}
+
+void
+skip_whitespace( const std::string& text, size_t& position )
+{
+  while ( position < text.size() && is_whitespace( text[ position ] ) )
+  {
+    ++position;
+  }
+}
+
+//position is on the opening quote, left after the closing one
+bool
+read_string( const std::string& text, size_t& position, std::string* value )
+{
+  for ( ++position; position < text.size(); ++position )
+  {
+    const char character( text[ position ] );
+    if ( character == '"' )
+    {
+      ++position;
+      return true;
+    }
+
+    if ( character == '\\' )
+    {
+      if ( ++position >= text.size() )
+      {
+        return false;
+      }
+
+      if ( value )
+      {
+        const char escaped( text[ position ] );
+        switch ( escaped )
+        {
+          case 'n': value->push_back( '\n' ); break;
+          case 't': value->push_back( '\t' ); break;
+          case 'r': value->push_back( '\r' ); break;
+          case 'b': value->push_back( '\b' ); break;
+          case 'f': value->push_back( '\f' ); break;
+          //unicode escapes are kept as they are
+          case 'u': value->append( "\\u" ); break;
+          default: value->push_back( escaped ); break;
+        }
+      }
+      continue;
+    }
+
+    if ( value )
+    {
+      value->push_back( character );
+    }
+  }
+
+  return false;
+}
+
+bool
+skip_container( const std::string& text, size_t& position )
+{
+  size_t depth( 0 );
+  while ( position < text.size() )
+  {
+    const char character( text[ position ] );
+    if ( character == '"' )
+    {
+      if ( !read_string( text, position, nullptr ) )
+      {
+        return false;
+      }
+      continue;
+    }
+
+    ++position;
+    if ( character == '{' || character == '[' )
+    {
+      ++depth;
+    }
+    else if ( ( character == '}' || character == ']' ) && --depth == 0 )
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}
+
+namespace yarrrs
+{
+
+namespace json
+{
+
+bool
+skip_value( const std::string& text, size_t& position )
+{
+  skip_whitespace( text, position );
+  if ( position >= text.size() )
+  {
+    return false;
+  }
+
+  const char first( text[ position ] );
+  if ( first == '{' || first == '[' )
+  {
+    return skip_container( text, position );
+  }
+
+  if ( first == '"' )
+  {
+    return read_string( text, position, nullptr );
+  }
+
+  const size_t start( position );
+  while ( position < text.size() &&
+      !is_whitespace( text[ position ] ) &&
+      text[ position ] != ',' && text[ position ] != '}' && text[ position ] != ']' )
+  {
+    ++position;
+  }
+
+  return position > start;
+}
+
+bool
+for_each_member( const std::string& text, const Slice& object, const MemberCallback& callback )
+{
+  size_t position( object.begin );
+  skip_whitespace( text, position );
+  if ( position >= object.end || text[ position ] != '{' )
+  {
+    return false;
+  }
+
+  ++position;
+  while ( true )
+  {
+    skip_whitespace( text, position );
+    if ( position >= object.end )
+    {
+      return false;
+    }
+
+    if ( text[ position ] == '}' )
+    {
+      return true;
+    }
+
+    std::string key;
+    if ( text[ position ] != '"' || !read_string( text, position, &key ) )
+    {
+      return false;
+    }
+
+    skip_whitespace( text, position );
+    if ( position >= object.end || text[ position ] != ':' )
+    {
+      return false;
+    }
+
+    ++position;
+    skip_whitespace( text, position );
+    Slice value{ position, position };
+    if ( !skip_value( text, position ) || position > object.end )
+    {
+      return false;
+    }
+
+    value.end = position;
+    callback( key, value );
+
+    skip_whitespace( text, position );
+    if ( position < object.end && text[ position ] == ',' )
+    {
+      ++position;
+    }
+  }
+}
+
+bool
+find( const std::string& text, const std::string& path, Slice& value )
+{
+  value = Slice{ 0, text.size() };
+  size_t key_begin( 0 );
+  while ( key_begin < path.size() )
+  {
+    const size_t key_end( std::min( path.find( '.', key_begin ), path.size() ) );
+    const std::string key( path.substr( key_begin, key_end - key_begin ) );
+    key_begin = key_end + 1;
+
+    bool is_found( false );
+    const Slice object( value );
+    for_each_member( text, object,
+        [ &key, &is_found, &value ]( const std::string& member, const Slice& member_value )
+        {
+          if ( !is_found && member == key )
+          {
+            is_found = true;
+            value = member_value;
+          }
+        } );
+
+    if ( !is_found )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::string
+quoted( const std::string& text )
+{
+  std::string quoted( "\"" );
+  for ( const char character : text )
+  {
+    switch ( character )
+    {
+      case '"': quoted.append( "\\\"" ); break;
+      case '\\': quoted.append( "\\\\" ); break;
+      case '\n': quoted.append( "\\n" ); break;
+      case '\t': quoted.append( "\\t" ); break;
+      case '\r': quoted.append( "\\r" ); break;
+      default:
+        if ( static_cast< unsigned char >( character ) < 0x20 )
+        {
+          char escaped[ 7 ];
+          std::snprintf( escaped, sizeof( escaped ), "\\u%04x", static_cast< unsigned int >( character ) );
+          quoted.append( escaped );
+          break;
+        }
+        quoted.push_back( character );
+        break;
+    }
+  }
+
+  quoted.push_back( '"' );
+  return quoted;
+}
+
+}
+
+}
+
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+namespace yarrrs
+{
+
+//Reads values out of a json text in place, without building a tree of it.
+namespace json
+{
+
+//the value between begin and end in the text
+class Slice
+{
+  public:
+    size_t begin;
+    size_t end;
+};
+
+//moves the position past the value starting at it, whitespace before it is skipped
+bool skip_value( const std::string& text, size_t& position );
+
+using MemberCallback = std::function< void( const std::string& key, const Slice& value ) >;
+//false when the slice is not an object
+bool for_each_member( const std::string& text, const Slice& object, const MemberCallback& );
+
+//the value at a dot separated path of keys, the empty path is the whole text
+bool find( const std::string& text, const std::string& path, Slice& value );
+
+std::string quoted( const std::string& );
+
+}
+
+}
+
@@ -11,6 +11,7 @@ namespace
 
 const std::string login_error_message( "Unable to log in.  Please restart the client with the --username command line parameter.  If you are unable to solve the issue send an email to info@yarrrthegame.com" );
 const std::string invalid_username_message( "Invalid username.  Username must not contain the following characters: space" );
+const std::string server_busy_message( "Server is busy, please try again in a few minutes." );
 const std::string database_error( "There seems to be a problem with the database, please notify: info@yarrrthegame.com" );
 
 
@@ -26,7 +27,10 @@ is_invalid_player_id( const std::string& player_id )
 namespace yarrrs
 {
 
-LoginHandler::LoginHandler( ConnectionWrapper& connection_wrapper, the::ctci::Dispatcher& dispatcher )
+LoginHandler::LoginHandler(
+    ConnectionWrapper& connection_wrapper,
+    the::ctci::Dispatcher& dispatcher,
+    AdmissionCheck is_admitting )
   : m_connection_wrapper( connection_wrapper )
   , m_connection( connection_wrapper.connection )
   , m_id( m_connection->id )
@@ -50,14 +54,36 @@ LoginHandler::LoginHandler( ConnectionWrapper& connection_wrapper, the::ctci::Di
             handle_authentication_response( cmd );
             return;
           }
+
+          if ( cmd.command() == Capabilities::negotiation )
+          {
+            handle_capabilities( cmd );
+            return;
+          }
         }) )
   , m_dispatcher( dispatcher )
   , m_was_authentication_request_sent_out( false )
   , m_modells( the::ctci::service< yarrr::ModellContainer >() )
+  , m_capabilities()
+  , m_is_admitting( std::move( is_admitting ) )
 {
 }
 
 
+bool
+LoginHandler::is_admitting() const
+{
+  if ( !m_is_admitting || m_is_admitting() )
+  {
+    return true;
+  }
+
+  thelog( yarrr::log::info )( "Login refused, the server is overloaded:", m_player_id );
+  send_login_error_message( server_busy_message );
+  return false;
+}
+
+
 void
 LoginHandler::send_login_error_message( const std::string& additional_information ) const
 {
@@ -93,12 +119,17 @@ LoginHandler::handle_registration_request( const yarrr::Command& request )
     return;
   }
 
+  if ( !is_admitting() )
+  {
+    return;
+  }
+
   auto& player( m_modells.create_with_id_if_needed( "player", m_player_id ) );
   const auto& auth_token( request.parameters()[ 1 ] );
   player[ yarrr::model::auth_token ] = auth_token;
 
   m_dispatcher.dispatch(
-      PlayerLoggedIn( m_connection_wrapper, m_id, m_player_id ) );
+      PlayerLoggedIn( m_connection_wrapper, m_id, m_player_id, m_capabilities ) );
 }
 
 
@@ -120,6 +151,11 @@ LoginHandler::handle_login_request( const yarrr::Command& request )
     return;
   }
 
+  if ( !is_admitting() )
+  {
+    return;
+  }
+
   const size_t challenge_length( 256u );
   m_challenge = yarrr::random( challenge_length );
   m_connection->send( yarrr::Command{ {
@@ -160,7 +196,20 @@ LoginHandler::handle_authentication_response( const yarrr::Command& response ) c
 void
 LoginHandler::log_in() const
 {
-  m_dispatcher.dispatch( PlayerLoggedIn( m_connection_wrapper, m_id, m_player_id ) );
+  m_dispatcher.dispatch( PlayerLoggedIn( m_connection_wrapper, m_id, m_player_id, m_capabilities ) );
+}
+
+
+void
+LoginHandler::handle_capabilities( const yarrr::Command& request )
+{
+  m_capabilities = Capabilities::supported().negotiate( request.parameters() );
+
+  std::vector< std::string > response{ Capabilities::negotiation };
+  const auto agreed_capabilities( m_capabilities.names() );
+  response.insert( std::end( response ), std::begin( agreed_capabilities ), std::end( agreed_capabilities ) );
+  thelog( yarrr::log::debug )( "Capabilities negotiated with connection", m_id, response.size() - 1 );
+  m_connection->send( yarrr::Command( std::move( response ) ).serialize() );
 }
 
 
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "capabilities.hpp"
 #include <yarrr/connection_wrapper.hpp>
 #include <thenet/connection.hpp>
+#include <functional>
 
 namespace yarrr
 {
@@ -35,16 +37,19 @@ class PlayerLoggedIn
     PlayerLoggedIn(
         ConnectionWrapper& connection_wrapper,
         int id,
-        const std::string& name )
+        const std::string& name,
+        const Capabilities& capabilities = Capabilities() )
       : connection_wrapper( connection_wrapper )
       , id( id )
       , name( name )
+      , capabilities( capabilities )
     {
     }
 
     ConnectionWrapper& connection_wrapper;
     const int id;
     const std::string& name;
+    const Capabilities capabilities;
 };
 
 class PlayerLoggedOut
@@ -62,13 +67,18 @@ class PlayerLoggedOut
 class LoginHandler
 {
   public:
-    LoginHandler( ConnectionWrapper& , the::ctci::Dispatcher& );
+    //Answers whether new players may log in right now, no check means always.
+    using AdmissionCheck = std::function< bool() >;
+
+    LoginHandler( ConnectionWrapper& , the::ctci::Dispatcher&, AdmissionCheck is_admitting = AdmissionCheck() );
     ~LoginHandler();
 
   private:
+    bool is_admitting() const;
     void handle_registration_request( const yarrr::Command& request );
     void handle_login_request( const yarrr::Command& request );
     void handle_authentication_response( const yarrr::Command& request ) const;
+    void handle_capabilities( const yarrr::Command& request );
     void log_in() const;
     void send_login_error_message( const std::string& additional_information ) const;
 
@@ -81,6 +91,8 @@ class LoginHandler
     std::string m_challenge;
     bool m_was_authentication_request_sent_out;
     yarrr::ModellContainer& m_modells;
+    Capabilities m_capabilities;
+    const AdmissionCheck m_is_admitting;
 };
 
 }
@@ -0,0 +1,391 @@
+#include "lua_cache.hpp"
+#include "configuration.hpp"
+#include "fnv.hpp"
+
+#include <yarrr/log.hpp>
+#include <lua.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <dirent.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+namespace
+{
+
+bool
+is_folder( const std::string& path )
+{
+  struct stat status;
+  return stat( path.c_str(), &status ) == 0 && S_ISDIR( status.st_mode );
+}
+
+bool
+exists( const std::string& path )
+{
+  struct stat status;
+  return stat( path.c_str(), &status ) == 0;
+}
+
+bool
+make_folder( const std::string& path )
+{
+  return mkdir( path.c_str(), 0755 ) == 0 || is_folder( path );
+}
+
+bool
+has_suffix( const std::string& name, const std::string& suffix )
+{
+  return
+    name.size() >= suffix.size() &&
+    name.compare( name.size() - suffix.size(), suffix.size(), suffix ) == 0;
+}
+
+std::vector< std::string >
+entries_of( const std::string& folder )
+{
+  std::vector< std::string > entries;
+  std::unique_ptr< DIR, int(*)( DIR* ) > directory( opendir( folder.c_str() ), closedir );
+  if ( !directory )
+  {
+    return entries;
+  }
+
+  while ( const dirent* entry = readdir( directory.get() ) )
+  {
+    const std::string name( entry->d_name );
+    if ( name != "." && name != ".." )
+    {
+      entries.push_back( name );
+    }
+  }
+
+  return entries;
+}
+
+void
+remove_tree( const std::string& path )
+{
+  struct stat status;
+  if ( lstat( path.c_str(), &status ) != 0 )
+  {
+    return;
+  }
+
+  if ( S_ISDIR( status.st_mode ) )
+  {
+    for ( const auto& name : entries_of( path ) )
+    {
+      remove_tree( path + "/" + name );
+    }
+
+    rmdir( path.c_str() );
+    return;
+  }
+
+  unlink( path.c_str() );
+}
+
+const std::string mirror_prefix( "lua-" );
+
+//every process has a mirror of its own, the ones of finished processes are removed
+void
+remove_stale_mirrors( const std::string& cache_folder )
+{
+  for ( const auto& name : entries_of( cache_folder ) )
+  {
+    if ( name.compare( 0, mirror_prefix.size(), mirror_prefix ) != 0 )
+    {
+      continue;
+    }
+
+    const pid_t pid( std::atoi( name.c_str() + mirror_prefix.size() ) );
+    if ( pid > 0 && kill( pid, 0 ) != 0 && errno == ESRCH )
+    {
+      remove_tree( cache_folder + name );
+    }
+  }
+}
+
+//the bytecode files the mirrors under the folder link to
+void
+collect_linked_files( const std::string& folder, std::set< std::string >& linked )
+{
+  for ( const auto& name : entries_of( folder ) )
+  {
+    const std::string path( folder + name );
+    struct stat status;
+    if ( lstat( path.c_str(), &status ) != 0 )
+    {
+      continue;
+    }
+
+    if ( S_ISDIR( status.st_mode ) )
+    {
+      collect_linked_files( path + "/", linked );
+      continue;
+    }
+
+    std::vector< char > target( PATH_MAX );
+    const ssize_t length( readlink( path.c_str(), target.data(), target.size() ) );
+    if ( length > 0 )
+    {
+      linked.emplace( target.data(), length );
+    }
+  }
+}
+
+//a starting process may have compiled a file without linking it yet
+const time_t bytecode_grace_seconds( 60 * 60 );
+
+//removes the bytecode no mirror of a running process links to, so the
+//cache does not grow with every version of the sources
+void
+remove_unlinked_bytecode( const std::string& cache_folder )
+{
+  std::set< std::string > linked;
+  for ( const auto& name : entries_of( cache_folder ) )
+  {
+    if ( name.compare( 0, mirror_prefix.size(), mirror_prefix ) == 0 )
+    {
+      collect_linked_files( cache_folder + name + "/", linked );
+    }
+  }
+
+  const std::string bytecode_folder( cache_folder + "bytecode/" );
+  const time_t now( time( nullptr ) );
+  for ( const auto& name : entries_of( bytecode_folder ) )
+  {
+    const std::string path( bytecode_folder + name );
+    struct stat status;
+    if ( linked.count( path ) == 0 &&
+         stat( path.c_str(), &status ) == 0 &&
+         now - status.st_mtime > bytecode_grace_seconds )
+    {
+      unlink( path.c_str() );
+    }
+  }
+}
+
+std::string
+with_trailing_slash( const std::string& folder )
+{
+  return folder.empty() || folder.back() == '/' ? folder : folder + "/";
+}
+
+bool
+read_file( const std::string& path, std::string& content )
+{
+  std::ifstream file( path, std::ios::binary );
+  if ( !file )
+  {
+    return false;
+  }
+
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  content = buffer.str();
+  return true;
+}
+
+int
+append_to_string( lua_State*, const void* data, size_t size, void* output )
+{
+  static_cast< std::string* >( output )->append( static_cast< const char* >( data ), size );
+  return 0;
+}
+
+std::string
+hex_of( uint64_t value )
+{
+  std::stringstream hex;
+  hex << std::hex << std::setw( 16 ) << std::setfill( '0' ) << value;
+  return hex.str();
+}
+
+}
+
+namespace yarrrs
+{
+
+std::string
+LuaCache::folder_from_configuration( const std::string& home_folder )
+{
+  const std::string folder( configured_or< std::string >( "lua_cache_folder", home_folder + "/.cache/yarrrserver/" ) );
+  return folder == "none" ? std::string() : folder;
+}
+
+LuaCache::LuaCache( const std::string& cache_folder )
+  : m_cache_folder( with_trailing_slash( cache_folder ) )
+  , m_mirrored_folder( m_cache_folder + mirror_prefix + std::to_string( getpid() ) + "/" )
+  , m_statistics{ 0, 0, 0 }
+  , m_number_of_mirrors( 0 )
+{
+}
+
+LuaCache::~LuaCache()
+{
+  //the bytecode of this mirror is kept for the next start
+  remove_unlinked_bytecode( m_cache_folder );
+  remove_tree( m_mirrored_folder );
+}
+
+//FNV-1a, the lua release is part of the hash as bytecode is not portable
+//between lua versions
+uint64_t
+LuaCache::hash_of( const std::string& content )
+{
+  const std::string release( LUA_RELEASE );
+  return fnv1a( content.data(), content.size(), fnv1a( release.data(), release.size() ) );
+}
+
+std::string
+LuaCache::mirror( const std::string& source_folder )
+{
+  if ( !is_folder( source_folder ) )
+  {
+    return source_folder;
+  }
+
+  if ( m_number_of_mirrors == 0 )
+  {
+    remove_stale_mirrors( m_cache_folder );
+    remove_tree( m_mirrored_folder );
+  }
+
+  const std::string mirrored_folder( m_mirrored_folder + std::to_string( m_number_of_mirrors++ ) + "/" );
+  if ( !make_folder( m_cache_folder ) ||
+       !make_folder( m_cache_folder + "bytecode/" ) ||
+       !make_folder( m_mirrored_folder ) ||
+       !mirror_into( source_folder, mirrored_folder ) )
+  {
+    thelog( yarrr::log::warning )( "Unable to cache lua bytecode of", source_folder, "in", m_cache_folder );
+    return source_folder;
+  }
+
+  thelog( yarrr::log::info )(
+      "Lua cache of", source_folder,
+      "compiled:", m_statistics.compiled,
+      "reused:", m_statistics.reused,
+      "linked:", m_statistics.linked );
+  return mirrored_folder;
+}
+
+const LuaCache::Statistics&
+LuaCache::statistics() const
+{
+  return m_statistics;
+}
+
+bool
+LuaCache::mirror_into( const std::string& source_folder, const std::string& mirrored_folder )
+{
+  if ( !make_folder( mirrored_folder ) )
+  {
+    return false;
+  }
+
+  for ( const auto& name : entries_of( source_folder ) )
+  {
+    const std::string source( source_folder + name );
+    const std::string mirrored( mirrored_folder + name );
+    if ( is_folder( source ) )
+    {
+      //the cache may be configured inside the folder it mirrors
+      if ( source + "/" != m_cache_folder && !mirror_into( source + "/", mirrored + "/" ) )
+      {
+        return false;
+      }
+    }
+    else if ( has_suffix( name, ".lua" ) && mirror_lua_file( source, mirrored ) )
+    {
+      continue;
+    }
+    else if ( symlink( source.c_str(), mirrored.c_str() ) == 0 )
+    {
+      ++m_statistics.linked;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool
+LuaCache::mirror_lua_file( const std::string& source, const std::string& mirrored )
+{
+  std::string content;
+  if ( !read_file( source, content ) )
+  {
+    return false;
+  }
+
+  const std::string bytecode_file( m_cache_folder + "bytecode/" + hex_of( hash_of( content ) ) + ".luac" );
+  if ( exists( bytecode_file ) )
+  {
+    //the age of a bytecode file is the time it was last used
+    utime( bytecode_file.c_str(), nullptr );
+    ++m_statistics.reused;
+  }
+  else if ( compile( content, "@" + source, bytecode_file ) )
+  {
+    ++m_statistics.compiled;
+  }
+  else
+  {
+    //the engine loads the source then and reports the error
+    return false;
+  }
+
+  return symlink( bytecode_file.c_str(), mirrored.c_str() ) == 0;
+}
+
+bool
+LuaCache::compile( const std::string& source, const std::string& chunk_name, const std::string& bytecode_file ) const
+{
+  std::unique_ptr< lua_State, void(*)( lua_State* ) > lua( luaL_newstate(), lua_close );
+  if ( !lua || luaL_loadbuffer( lua.get(), source.data(), source.size(), chunk_name.c_str() ) != 0 )
+  {
+    thelog( yarrr::log::warning )( "Unable to compile", chunk_name, lua ? lua_tostring( lua.get(), -1 ) : "" );
+    return false;
+  }
+
+  std::string bytecode;
+#if LUA_VERSION_NUM >= 503
+  lua_dump( lua.get(), append_to_string, &bytecode, 0 );
+#else
+  lua_dump( lua.get(), append_to_string, &bytecode );
+#endif
+
+  //written aside and renamed, so a concurrent start never loads half a file
+  const std::string written_file( bytecode_file + "." + std::to_string( getpid() ) );
+  std::ofstream file( written_file, std::ios::binary );
+  file.write( bytecode.data(), bytecode.size() );
+  file.close();
+  if ( !file || std::rename( written_file.c_str(), bytecode_file.c_str() ) != 0 )
+  {
+    std::remove( written_file.c_str() );
+    return false;
+  }
+
+  return true;
+}
+
+}
+
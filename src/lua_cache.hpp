@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace yarrrs
+{
+
+//Mirrors a folder of lua sources with every .lua file replaced by its
+//precompiled bytecode, so the lua engine loads the mirror without parsing the
+//sources again.  Bytecode is stored under the hash of the source and the lua
+//release, a changed source is compiled again, other files are linked.  The
+//mirror is removed with the cache.  The bytecode it links to is kept for the
+//next start, bytecode unused by every mirror for an hour is removed.
+class LuaCache
+{
+  public:
+    class Statistics
+    {
+      public:
+        size_t compiled;
+        size_t reused;
+        size_t linked;
+    };
+
+    //empty when the cache is turned off
+    static std::string folder_from_configuration( const std::string& home_folder );
+
+    LuaCache( const std::string& cache_folder );
+    ~LuaCache();
+
+    LuaCache( const LuaCache& ) = delete;
+    LuaCache& operator=( const LuaCache& ) = delete;
+
+    //every source folder gets a mirror of its own, returns the mirrored
+    //folder, or the source folder when it is missing or can not be mirrored
+    std::string mirror( const std::string& source_folder );
+    const Statistics& statistics() const;
+
+    static uint64_t hash_of( const std::string& content );
+
+  private:
+    bool mirror_into( const std::string& source_folder, const std::string& mirrored_folder );
+    bool mirror_lua_file( const std::string& source, const std::string& mirrored );
+    bool compile( const std::string& source, const std::string& chunk_name, const std::string& bytecode_file ) const;
+
+    const std::string m_cache_folder;
+    const std::string m_mirrored_folder;
+    Statistics m_statistics;
+    size_t m_number_of_mirrors;
+};
+
+}
+
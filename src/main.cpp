@@ -3,6 +3,22 @@
 #include "world.hpp"
 #include "models.hpp"
 #include "redis.hpp"
+#include "redis_cluster_store.hpp"
+#include "mission_updater.hpp"
+#include "export_scheduler.hpp"
+#include "tick_histogram.hpp"
+#include "object_updates.hpp"
+#include "metrics.hpp"
+#include "metrics_exporter.hpp"
+#include "overload_controller.hpp"
+#include "configuration.hpp"
+#include "worker_pool.hpp"
+#include "zones.hpp"
+#include "cluster.hpp"
+#include "lua_cache.hpp"
+#include "model_snapshot.hpp"
+#include "remote_model_server.hpp"
+#include "remote_model_feed.hpp"
 
 #include <yarrr/lua_setup.hpp>
 #include <yarrr/object_container.hpp>
@@ -21,20 +37,37 @@
 #include <thetime/once_in.hpp>
 #include <thectci/service_registry.hpp>
 #include <theconf/configuration.hpp>
-#include <themodel/zmq_remote.hpp>
 #include <themodel/json_exporter.hpp>
 #include <thenet/address.hpp>
 
 #include <iostream>
 #include <fstream>
+#include <chrono>
+#include <algorithm>
 
 #include <stdlib.h>
 
 namespace
 {
 
-std::unique_ptr< the::model::ZmqRemote >
-create_remote_model_endpoint_if_needed()
+constexpr int simulation_frequency( 10 );
+
+std::unique_ptr< yarrrs::MetricsExporter >
+create_metrics_exporter_if_needed()
+{
+  const auto metrics_port_key( "metrics_port" );
+  if ( !the::conf::has( metrics_port_key ) )
+  {
+    return nullptr;
+  }
+
+  return std::make_unique< yarrrs::MetricsExporter >(
+      the::ctci::service< yarrrs::Metrics >(),
+      the::conf::get< int >( metrics_port_key ) );
+}
+
+std::unique_ptr< yarrrs::RemoteModelServer >
+create_remote_model_endpoint_if_needed( yarrrs::ModelSnapshot& model_snapshot )
 {
   const auto remote_model_endpoint_key( "remote-model-endpoint" );
   if ( !the::conf::has( remote_model_endpoint_key ) )
@@ -42,28 +75,104 @@ create_remote_model_endpoint_if_needed()
     return nullptr;
   }
 
-  return std::make_unique< the::model::ZmqRemote >(
-    the::conf::get<std::string>( remote_model_endpoint_key ).c_str(),
-    yarrr::LuaEngine::model(),
-    the::model::export_json );
+  return std::make_unique< yarrrs::RemoteModelServer >(
+    the::conf::get<std::string>( remote_model_endpoint_key ),
+    model_snapshot,
+    []( const std::string& code ) { yarrr::LuaEngine::model().run( code ); } );
+}
+
+std::unique_ptr< yarrrs::RemoteModelFeed >
+create_remote_model_feed_if_needed( yarrrs::ModelSnapshot& model_snapshot )
+{
+  const auto remote_model_feed_key( "remote-model-feed" );
+  if ( !the::conf::has( remote_model_feed_key ) )
+  {
+    return nullptr;
+  }
+
+  return std::make_unique< yarrrs::RemoteModelFeed >(
+    the::conf::get<std::string>( remote_model_feed_key ),
+    model_snapshot,
+    yarrrs::RemoteModelFeed::interval_from_configuration() );
 }
 
 void
 send_update_messages_from(
     const yarrr::ObjectContainer& objects,
-    yarrrs::Player::Container& players )
+    yarrrs::Player::Container& players,
+    yarrrs::NetworkService& network_service,
+    const yarrrs::DistantUpdates& distant_updates,
+    const yarrrs::UpdatePriorities& priorities,
+    const yarrrs::CompactPhysics& compact_physics,
+    yarrrs::Zones* zones )
 {
-  std::vector< yarrr::ObjectUpdate::Pointer > object_updates( objects.generate_object_updates() );
-  std::vector< yarrr::Data > update_messages;
-  for ( const auto& update : object_updates )
+  for ( const auto& id : yarrrs::send_object_updates(
+        objects, players, priorities, compact_physics, distant_updates, zones ) )
   {
-    const yarrr::Data message( update->serialize() );
+    thelog( yarrr::log::warning )( "Dropping player unable to keep up with updates:", players[ id ]->name );
+    network_service.drop_connection( id );
+  }
+}
 
-    for ( const auto& player : players )
-    {
-      player.second->send( yarrr::Data( message ) );
-    }
 
+yarrrs::DistantUpdates
+distant_updates_under( const yarrrs::OverloadController& overload_controller, int64_t tick )
+{
+  if ( !overload_controller.is_at_least( yarrrs::OverloadController::distant_updates_throttled ) )
+  {
+    return yarrrs::DistantUpdates{ 0, 1, tick };
+  }
+
+  return yarrrs::DistantUpdates::from_configuration( tick );
+}
+
+
+std::unique_ptr< yarrrs::Cluster >
+join_cluster_if_needed( yarrrs::Cluster::Store& store )
+{
+  const yarrrs::Cluster::Configuration configuration( yarrrs::Cluster::Configuration::from_configuration() );
+  if ( configuration.node_id.empty() )
+  {
+    return nullptr;
+  }
+
+  return std::make_unique< yarrrs::Cluster >( store, configuration );
+}
+
+
+void
+hand_off_players_of(
+    yarrrs::Cluster& cluster,
+    yarrrs::Player::Container& players,
+    const yarrr::ObjectContainer& objects,
+    yarrrs::NetworkService& network_service,
+    const yarrrs::Zones* zones )
+{
+  for ( const auto& id : cluster.tick( players, objects, zones ) )
+  {
+    network_service.drop_connection( id );
+  }
+}
+
+
+void
+record_startup_phase( const std::string& phase, std::chrono::steady_clock::time_point started )
+{
+  const std::chrono::duration< double > duration( std::chrono::steady_clock::now() - started );
+  thelog( yarrr::log::info )( "Startup phase", phase, "took", duration.count(), "seconds." );
+  the::ctci::service< yarrrs::Metrics >().gauge(
+      "yarrr_startup_seconds",
+      "Time spent on the phases of the startup.",
+      yarrrs::Metrics::label( "phase", phase ) ).set( duration.count() );
+}
+
+
+void
+flush_model_changes_of( yarrrs::Player::Container& players )
+{
+  for ( auto& player : players )
+  {
+    player.second->flush_model_changes();
   }
 }
 
@@ -74,6 +183,45 @@ print_help_and_exit()
   std::cout << "usage: yarrrserver --port <port>" << std::endl;
   std::cout << "  --loglevel <int>" << std::endl;
   std::cout << "  --redis_url <ip:port>" << std::endl;
+  std::cout << "  --outbound_bytes_per_tick <int>" << std::endl;
+  std::cout << "  --outbound_queue_limit <int>" << std::endl;
+  std::cout << "  --slow_client_policy <drop_stale|degrade|disconnect>" << std::endl;
+  std::cout << "  --slow_client_grace_ticks <int>" << std::endl;
+  std::cout << "  --compression_threshold <int>" << std::endl;
+  std::cout << "  --chat_burst <int>" << std::endl;
+  std::cout << "  --chat_ticks_per_message <int>" << std::endl;
+  std::cout << "  --chat_proximity_radius <int>" << std::endl;
+  std::cout << "  --ship_pool_spares <int>" << std::endl;
+  std::cout << "  --metrics_port <int>" << std::endl;
+  std::cout << "  --overload_raise_ratio <float>" << std::endl;
+  std::cout << "  --overload_lower_ratio <float>" << std::endl;
+  std::cout << "  --overload_heavy_ticks_to_raise <int>" << std::endl;
+  std::cout << "  --overload_light_ticks_to_lower <int>" << std::endl;
+  std::cout << "  --distant_update_radius <int>" << std::endl;
+  std::cout << "  --distant_update_interval <int>" << std::endl;
+  std::cout << "  --update_priority_own_ship <float>" << std::endl;
+  std::cout << "  --update_priority_half_distance <int>" << std::endl;
+  std::cout << "  --update_priority_double_speed <int>" << std::endl;
+  std::cout << "  --dead_reckoning_position_tolerance <int>" << std::endl;
+  std::cout << "  --dead_reckoning_angle_tolerance <int>" << std::endl;
+  std::cout << "  --dead_reckoning_keyframe_ticks <int>" << std::endl;
+  std::cout << "  --compact_position_step <int>" << std::endl;
+  std::cout << "  --compact_velocity_step <int>" << std::endl;
+  std::cout << "  --compact_angle_per_turn <int>" << std::endl;
+  std::cout << "  --zone_size <int>" << std::endl;
+  std::cout << "  --worker_threads <int>" << std::endl;
+  std::cout << "  --deferred_work_interval <int>" << std::endl;
+  std::cout << "  --object_export_interval <int>" << std::endl;
+  std::cout << "  --cluster_node_id <name>" << std::endl;
+  std::cout << "  --cluster_address <host:port>" << std::endl;
+  std::cout << "  --cluster_lease_milliseconds <int>" << std::endl;
+  std::cout << "  --cluster_renew_interval <int>" << std::endl;
+  std::cout << "  --lua_cache_folder <path|none>" << std::endl;
+  std::cout << "  --remote-model-endpoint <zmq endpoint>" << std::endl;
+  std::cout << "  --remote_model_max_age <milliseconds>" << std::endl;
+  std::cout << "  --remote_model_versions_kept <int>" << std::endl;
+  std::cout << "  --remote-model-feed <zmq endpoint>" << std::endl;
+  std::cout << "  --remote_model_feed_interval <milliseconds>" << std::endl;
   exit( 0 );
 }
 
@@ -123,50 +271,154 @@ int main( int argc, char ** argv )
       id_generator,
       db.get() );
 
-  const std::string home_folder( std::string( getenv( "HOME" ) ) + "/.yarrrserver/" );
-  the::conf::set( "lua_configuration_path", home_folder );
-
-  the::ctci::AutoServiceRegister< yarrr::ResourceFinder, yarrr::ResourceFinder > resource_finder_register(
-      yarrr::ResourceFinder::PathList{
+  const std::string home( getenv( "HOME" ) );
+  const std::string home_folder( home + "/.yarrrserver/" );
+  const auto lua_cache_started( std::chrono::steady_clock::now() );
+  const std::string lua_cache_folder( yarrrs::LuaCache::folder_from_configuration( home ) );
+  std::unique_ptr< yarrrs::LuaCache > lua_cache( lua_cache_folder.empty() ?
+      nullptr :
+      std::make_unique< yarrrs::LuaCache >( lua_cache_folder ) );
+  yarrr::ResourceFinder::PathList resource_folders{
       home_folder,
       "/usr/local/share/yarrr/",
-      "/usr/share/yarrr/" } );
+      "/usr/share/yarrr/" };
+  if ( lua_cache )
+  {
+    for ( auto& folder : resource_folders )
+    {
+      folder = lua_cache->mirror( folder );
+    }
+  }
+  the::conf::set( "lua_configuration_path", resource_folders.front() );
+  record_startup_phase( "lua_cache", lua_cache_started );
 
+  the::ctci::AutoServiceRegister< yarrr::ResourceFinder, yarrr::ResourceFinder > resource_finder_register(
+      resource_folders );
+
+  const auto lua_engine_started( std::chrono::steady_clock::now() );
   yarrr::initialize_lua_engine();
+  record_startup_phase( "lua_engine", lua_engine_started );
 
   the::time::Clock clock;
   yarrr::ClockExporter clock_exporter( clock, yarrr::LuaEngine::model() );
   yarrrs::NetworkService network_service( clock );
   yarrr::ObjectContainer object_container;
   yarrr::ObjectExporter object_exporter( object_container, yarrr::LuaEngine::model() );
+  yarrrs::ExportScheduler object_export(
+      [ &object_exporter ]() { object_exporter.refresh(); },
+      yarrrs::ExportScheduler::interval_from_configuration() );
   yarrrs::Player::Container players;
-  yarrrs::World world( players, object_container );
+  yarrrs::RedisClusterStore cluster_store;
+  std::unique_ptr< yarrrs::Cluster > cluster( join_cluster_if_needed( cluster_store ) );
+  yarrrs::World world( players, object_container, cluster.get() );
+
+  the::time::FrequencyStabilizer< simulation_frequency, the::time::Clock > frequency_stabilizer( clock );
+  yarrrs::MissionUpdater mission_updater(
+      players,
+      simulation_frequency,
+      [ &object_export ]() { object_export.before_reading(); } );
 
-  the::time::FrequencyStabilizer< 10, the::time::Clock > frequency_stabilizer( clock );
-  the::time::OnceIn< the::time::Clock > update_missions_once_per_second( clock, the::time::Clock::ticks_per_second,
-      [ &players ]( const the::time::Time& )
+  yarrrs::TickHistogram tick_histogram( std::chrono::milliseconds( 1 ), 1000 / simulation_frequency * 2 );
+  the::time::OnceIn< the::time::Clock > report_tick_histogram_once_per_minute( clock, the::time::Clock::ticks_per_second * 60,
+      [ &tick_histogram ]( const the::time::Time& )
       {
-        for ( auto& player : players )
-        {
-          player.second->update_missions();
-        }
+        thelog( yarrr::log::info )( "Tick durations", tick_histogram.summary() );
+        tick_histogram.reset();
       } );
 
-  std::unique_ptr< the::model::ZmqRemote > remote_model_access( create_remote_model_endpoint_if_needed() );
+  //themodel exports only a whole tree, so every snapshot is a full export;
+  //subtrees and changes are cut from it on the endpoint threads
+  yarrrs::ModelSnapshot model_snapshot(
+      [ &object_export ]()
+      {
+        object_export.before_reading();
+        return the::model::export_json( yarrr::LuaEngine::model() );
+      },
+      yarrrs::ModelSnapshot::max_age_from_configuration() );
+  std::unique_ptr< yarrrs::RemoteModelServer > remote_model_access( create_remote_model_endpoint_if_needed( model_snapshot ) );
+  std::unique_ptr< yarrrs::RemoteModelFeed > remote_model_feed( create_remote_model_feed_if_needed( model_snapshot ) );
+  std::unique_ptr< yarrrs::MetricsExporter > metrics_exporter( create_metrics_exporter_if_needed() );
+
+  yarrrs::Metrics& metrics( the::ctci::service< yarrrs::Metrics >() );
+  const auto tick_budget( std::chrono::milliseconds( 1000 / simulation_frequency ) );
+  yarrrs::Metrics::Value& ticks( metrics.counter( "yarrr_ticks_total", "Simulation ticks." ) );
+  yarrrs::Metrics::Value& tick_overruns( metrics.counter(
+        "yarrr_tick_overruns_total", "Ticks with more work than the tick length." ) );
+  yarrrs::Metrics::Value& tick_seconds( metrics.gauge(
+        "yarrr_last_tick_seconds", "Work done in the last tick." ) );
 
+  yarrrs::OverloadController overload_controller( yarrrs::OverloadController::Limits::from_configuration(
+        std::chrono::duration_cast< yarrrs::OverloadController::Duration >( tick_budget ) ) );
+  const int deferred_work_interval( std::max( 1, yarrrs::configured_or< int >( "deferred_work_interval", 5 ) ) );
+  yarrrs::Metrics::Value& overload_stage( metrics.gauge(
+        "yarrr_overload_stage", "Load shedding stage, zero when the server keeps up." ) );
+  std::vector< yarrrs::Metrics::Value* > ticks_in_stage;
+  for ( int stage( yarrrs::OverloadController::normal ); stage <= yarrrs::OverloadController::logins_paused; ++stage )
+  {
+    ticks_in_stage.push_back( &metrics.counter(
+          "yarrr_overload_stage_ticks_total",
+          "Ticks spent in each load shedding stage.",
+          yarrrs::Metrics::label( "stage",
+            yarrrs::OverloadController::name_of( yarrrs::OverloadController::Stage( stage ) ) ) ) );
+  }
+
+  const yarrrs::UpdatePriorities update_priorities( yarrrs::UpdatePriorities::from_configuration() );
+  const yarrrs::CompactPhysics compact_physics( yarrrs::CompactPhysics::Quantization::from_configuration() );
+  const int64_t zone_size( yarrrs::Zones::size_from_configuration() );
+  std::unique_ptr< yarrrs::WorkerPool > workers( zone_size > 0 ?
+      std::make_unique< yarrrs::WorkerPool >( yarrrs::WorkerPool::threads_from_configuration() ) :
+      nullptr );
+  std::unique_ptr< yarrrs::Zones > zones( zone_size > 0 ?
+      std::make_unique< yarrrs::Zones >( zone_size, *workers ) :
+      nullptr );
+  int64_t tick( 0 );
   while ( true )
   {
+    ++tick;
+    const auto tick_start( std::chrono::steady_clock::now() );
+    const bool is_background_work_due(
+        !overload_controller.is_at_least( yarrrs::OverloadController::background_work_deferred ) ||
+        tick % deferred_work_interval == 0 );
     network_service.process_network_events();
     object_container.dispatch( yarrr::TimerUpdate( clock.now() ) );
     object_container.check_collision();
-    object_exporter.refresh();
-    send_update_messages_from( object_container, players );
-    update_missions_once_per_second.tick();
+    send_update_messages_from(
+        object_container, players, network_service,
+        distant_updates_under( overload_controller, tick ),
+        update_priorities,
+        compact_physics,
+        zones.get() );
+    if ( is_background_work_due )
+    {
+      mission_updater.tick();
+    }
+    world.tick();
+    if ( cluster )
+    {
+      hand_off_players_of( *cluster, players, object_container, network_service, zones.get() );
+    }
+    object_export.tick();
+    flush_model_changes_of( players );
+    model_snapshot.publish_if_requested();
+    const auto tick_duration( std::chrono::steady_clock::now() - tick_start );
+    tick_histogram.record( std::chrono::duration_cast< yarrrs::TickHistogram::Duration >( tick_duration ) );
+    ticks.increment();
+    tick_seconds.set( std::chrono::duration< double >( tick_duration ).count() );
+    if ( tick_duration > tick_budget )
+    {
+      tick_overruns.increment();
+    }
+    overload_controller.record( std::chrono::duration_cast< yarrrs::OverloadController::Duration >( tick_duration ) );
+    network_service.pause_logins( overload_controller.is_at_least( yarrrs::OverloadController::logins_paused ) );
+    overload_stage.set( overload_controller.stage() );
+    ticks_in_stage[ overload_controller.stage() ]->increment();
+    report_tick_histogram_once_per_minute.tick();
     frequency_stabilizer.stabilize();
     the::ctci::service< yarrr::MainThreadCallbackQueue >().process_callbacks();
-    if ( remote_model_access )
+
+    if ( metrics_exporter )
     {
-      remote_model_access->handle_requests();
+      metrics_exporter->serve_pending_requests();
     }
   }
 
@@ -0,0 +1,147 @@
+#include "metrics.hpp"
+
+#include <cmath>
+#include <sstream>
+
+namespace
+{
+
+void
+write_value( std::ostream& output, double value )
+{
+  if ( std::floor( value ) == value && std::fabs( value ) < 1e15 )
+  {
+    output << static_cast< long long >( value );
+    return;
+  }
+
+  output << value;
+}
+
+}
+
+namespace yarrrs
+{
+
+Metrics::Value::Value()
+  : m_value( 0.0 )
+{
+}
+
+void
+Metrics::Value::increment( double by )
+{
+  m_value += by;
+}
+
+void
+Metrics::Value::set( double value )
+{
+  m_value = value;
+}
+
+double
+Metrics::Value::get() const
+{
+  return m_value;
+}
+
+std::string
+Metrics::label( const std::string& name, const std::string& value )
+{
+  std::string escaped;
+  for ( const char character : value )
+  {
+    if ( character == '"' || character == '\\' )
+    {
+      escaped += '\\';
+    }
+    escaped += character == '\n' ? ' ' : character;
+  }
+
+  return name + "=\"" + escaped + "\"";
+}
+
+Metrics::Value&
+Metrics::counter( const std::string& name, const std::string& help, const std::string& labels )
+{
+  return value_of( name, help, "counter", labels );
+}
+
+Metrics::Value&
+Metrics::gauge( const std::string& name, const std::string& help, const std::string& labels )
+{
+  return value_of( name, help, "gauge", labels );
+}
+
+Metrics::Value&
+Metrics::value_of(
+    const std::string& name,
+    const std::string& help,
+    const std::string& type,
+    const std::string& labels )
+{
+  Family& family( m_families[ name ] );
+  if ( family.type.empty() )
+  {
+    family.help = help;
+    family.type = type;
+  }
+
+  return family.values[ labels ];
+}
+
+void
+Metrics::remove( const std::string& name, const std::string& labels )
+{
+  const auto family( m_families.find( name ) );
+  if ( family == std::end( m_families ) )
+  {
+    return;
+  }
+
+  family->second.values.erase( labels );
+}
+
+std::string
+Metrics::export_text() const
+{
+  std::ostringstream output;
+  output.precision( 9 );
+  for ( const auto& family : m_families )
+  {
+    output << "# HELP " << family.first << " " << family.second.help << "\n";
+    output << "# TYPE " << family.first << " " << family.second.type << "\n";
+    for ( const auto& value : family.second.values )
+    {
+      output << family.first;
+      if ( !value.first.empty() )
+      {
+        output << "{" << value.first << "}";
+      }
+      output << " ";
+      write_value( output, value.second.get() );
+      output << "\n";
+    }
+  }
+
+  return output.str();
+}
+
+Traffic::Traffic( Metrics& metrics, const std::string& type )
+  : m_messages( metrics.counter(
+        "yarrr_sent_messages_total", "Messages sent to players.", Metrics::label( "type", type ) ) )
+  , m_bytes( metrics.counter(
+        "yarrr_sent_bytes_total", "Bytes sent to players after compression.", Metrics::label( "type", type ) ) )
+{
+}
+
+void
+Traffic::count( size_t bytes ) const
+{
+  m_messages.increment();
+  m_bytes.increment( double( bytes ) );
+}
+
+}
+
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <thectci/id.hpp>
+#include <map>
+#include <string>
+
+namespace yarrrs
+{
+
+//Counters and gauges of the server, exported in the Prometheus text format.
+//A value is identified by its name and labels; the reference returned for it
+//stays valid as long as the registry lives.  Not thread safe, use it from the
+//main thread.
+class Metrics
+{
+  public:
+    add_ctci( "yarrrs_metrics" );
+
+    class Value
+    {
+      public:
+        Value();
+
+        void increment( double by = 1.0 );
+        void set( double value );
+        double get() const;
+
+      private:
+        double m_value;
+    };
+
+    static std::string label( const std::string& name, const std::string& value );
+
+    Value& counter( const std::string& name, const std::string& help, const std::string& labels = "" );
+    Value& gauge( const std::string& name, const std::string& help, const std::string& labels = "" );
+    //for values of something gone, like a logged out player, the reference
+    //to the value becomes invalid
+    void remove( const std::string& name, const std::string& labels );
+
+    std::string export_text() const;
+
+  private:
+    class Family
+    {
+      public:
+        std::string help;
+        std::string type;
+        std::map< std::string, Value > values;
+    };
+
+    Value& value_of(
+        const std::string& name,
+        const std::string& help,
+        const std::string& type,
+        const std::string& labels );
+
+    std::map< std::string, Family > m_families;
+};
+
+//Message and byte counters of one type of outgoing message.
+class Traffic
+{
+  public:
+    Traffic( Metrics&, const std::string& type );
+    void count( size_t bytes ) const;
+
+  private:
+    Metrics::Value& m_messages;
+    Metrics::Value& m_bytes;
+};
+
+}
+
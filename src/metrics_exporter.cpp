@@ -0,0 +1,185 @@
+#include "metrics_exporter.hpp"
+#include "metrics.hpp"
+
+#include <yarrr/log.hpp>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+namespace
+{
+
+const int max_requests_per_tick( 8 );
+const size_t max_open_responses( 8 );
+const int ticks_to_send_a_response( 100 );
+
+bool
+set_non_blocking( int socket )
+{
+  const int flags( fcntl( socket, F_GETFL, 0 ) );
+  return flags >= 0 && fcntl( socket, F_SETFL, flags | O_NONBLOCK ) == 0;
+}
+
+int
+listen_on_loopback( int port )
+{
+  const int listening_socket( socket( AF_INET, SOCK_STREAM, 0 ) );
+  if ( listening_socket < 0 )
+  {
+    return -1;
+  }
+
+  const int reuse_address( 1 );
+  setsockopt( listening_socket, SOL_SOCKET, SO_REUSEADDR, &reuse_address, sizeof( reuse_address ) );
+
+  sockaddr_in address;
+  std::memset( &address, 0, sizeof( address ) );
+  address.sin_family = AF_INET;
+  address.sin_port = htons( port );
+  address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+
+  if ( bind( listening_socket, reinterpret_cast< sockaddr* >( &address ), sizeof( address ) ) != 0 ||
+       listen( listening_socket, max_requests_per_tick ) != 0 ||
+       !set_non_blocking( listening_socket ) )
+  {
+    close( listening_socket );
+    return -1;
+  }
+
+  return listening_socket;
+}
+
+}
+
+namespace yarrrs
+{
+
+MetricsExporter::MetricsExporter( const Metrics& metrics, int port )
+  : m_metrics( metrics )
+  , m_socket( listen_on_loopback( port ) )
+{
+  if ( !is_listening() )
+  {
+    thelog( yarrr::log::error )( "Unable to export metrics on port", port, std::strerror( errno ) );
+    return;
+  }
+
+  thelog( yarrr::log::info )( "Exporting metrics on 127.0.0.1:", port );
+}
+
+MetricsExporter::~MetricsExporter()
+{
+  for ( const auto& response : m_responses )
+  {
+    close( response.client );
+  }
+
+  if ( is_listening() )
+  {
+    close( m_socket );
+  }
+}
+
+bool
+MetricsExporter::is_listening() const
+{
+  return m_socket >= 0;
+}
+
+void
+MetricsExporter::serve_pending_requests()
+{
+  if ( !is_listening() )
+  {
+    return;
+  }
+
+  for ( int i( 0 ); i < max_requests_per_tick && m_responses.size() < max_open_responses; ++i )
+  {
+    const int client( accept( m_socket, nullptr, nullptr ) );
+    if ( client < 0 )
+    {
+      break;
+    }
+
+    answer( client );
+  }
+
+  m_responses.erase(
+      std::remove_if( std::begin( m_responses ), std::end( m_responses ),
+        [ this ]( Response& response )
+        {
+          if ( send_rest_of( response ) && --response.ticks_left > 0 )
+          {
+            return false;
+          }
+
+          close( response.client );
+          return true;
+        } ),
+      std::end( m_responses ) );
+}
+
+void
+MetricsExporter::answer( int client )
+{
+  if ( !set_non_blocking( client ) )
+  {
+    close( client );
+    return;
+  }
+
+  //the request is not parsed, every path gets the metrics
+  char request[ 1024 ];
+  while ( recv( client, request, sizeof( request ), 0 ) == sizeof( request ) )
+  {
+  }
+
+  const std::string body( m_metrics.export_text() );
+  m_responses.push_back( Response{
+      client,
+      "HTTP/1.0 200 OK\r\n"
+      "Content-Type: text/plain; version=0.0.4\r\n"
+      "Content-Length: " + std::to_string( body.size() ) + "\r\n"
+      "Connection: close\r\n"
+      "\r\n" + body,
+      0,
+      ticks_to_send_a_response } );
+}
+
+bool
+MetricsExporter::send_rest_of( Response& response ) const
+{
+  while ( response.written < response.data.size() )
+  {
+    const ssize_t result( send(
+          response.client,
+          response.data.data() + response.written,
+          response.data.size() - response.written,
+          MSG_NOSIGNAL ) );
+    if ( result < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK ) )
+    {
+      return true;
+    }
+
+    if ( result <= 0 )
+    {
+      return false;
+    }
+
+    response.written += result;
+  }
+
+  return false;
+}
+
+}
+
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace yarrrs
+{
+
+class Metrics;
+
+//Serves the metrics over plain HTTP on a port of the loopback interface.
+//Every socket is non-blocking and polled once per tick, so a scrape costs the
+//main loop one export and never waits for the network.  A response that does
+//not fit in the socket buffer is carried over to the next ticks, a scraper
+//that does not read it for too long is hung up on.
+class MetricsExporter
+{
+  public:
+    MetricsExporter( const Metrics&, int port );
+    ~MetricsExporter();
+
+    MetricsExporter( const MetricsExporter& ) = delete;
+    MetricsExporter& operator=( const MetricsExporter& ) = delete;
+
+    bool is_listening() const;
+    void serve_pending_requests();
+
+  private:
+    class Response
+    {
+      public:
+        int client;
+        std::string data;
+        size_t written;
+        int ticks_left;
+    };
+
+    void answer( int client );
+    //false once the response is sent or the client is gone
+    bool send_rest_of( Response& ) const;
+
+    const Metrics& m_metrics;
+    int m_socket;
+    std::vector< Response > m_responses;
+};
+
+}
+
@@ -0,0 +1,65 @@
+#include "mission_updater.hpp"
+#include "login_handler.hpp"
+#include "local_event_dispatcher.hpp"
+
+#include <thectci/service_registry.hpp>
+
+namespace yarrrs
+{
+
+MissionUpdater::MissionUpdater(
+    Player::Container& players,
+    size_t ticks_per_period,
+    BeforeUpdating before_updating )
+  : m_players( players )
+  , m_wheel( ticks_per_period )
+  , m_before_updating( std::move( before_updating ) )
+{
+  the::ctci::Dispatcher& local_event_dispatcher(
+      the::ctci::service< LocalEventDispatcher >().dispatcher );
+
+  local_event_dispatcher.register_listener< PlayerLoggedIn >(
+      [ this ]( const PlayerLoggedIn& logged_in ){ handle_player_logged_in( logged_in ); } );
+
+  local_event_dispatcher.register_listener< PlayerLoggedOut >(
+      [ this ]( const PlayerLoggedOut& logged_out ){ handle_player_logged_out( logged_out ); } );
+}
+
+void
+MissionUpdater::handle_player_logged_in( const PlayerLoggedIn& logged_in )
+{
+  m_wheel.add( logged_in.id );
+}
+
+void
+MissionUpdater::handle_player_logged_out( const PlayerLoggedOut& logged_out )
+{
+  m_wheel.remove( logged_out.id );
+}
+
+void
+MissionUpdater::tick()
+{
+  bool is_prepared( false );
+  m_wheel.tick(
+      [ this, &is_prepared ]( TimingWheel::Key id )
+      {
+        //the login might have been refused by the world
+        const auto player( m_players.find( id ) );
+        if ( player == std::end( m_players ) )
+        {
+          return;
+        }
+
+        if ( !is_prepared )
+        {
+          m_before_updating();
+          is_prepared = true;
+        }
+
+        player->second->update_missions();
+      } );
+}
+
+}
+
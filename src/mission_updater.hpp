@@ -0,0 +1,37 @@
+#pragma once
+
+#include "player.hpp"
+#include "timing_wheel.hpp"
+#include <functional>
+
+namespace yarrrs
+{
+
+class PlayerLoggedIn;
+class PlayerLoggedOut;
+
+//Updates the missions of every player once in a period, but only a slice of
+//the players in each tick.  Before the first mission update of a tick it
+//calls back, e.g. to refresh what the missions read from the lua model.
+class MissionUpdater
+{
+  public:
+    using BeforeUpdating = std::function< void() >;
+
+    MissionUpdater(
+        Player::Container&,
+        size_t ticks_per_period,
+        BeforeUpdating before_updating = []() {} );
+    void tick();
+
+  private:
+    void handle_player_logged_in( const PlayerLoggedIn& );
+    void handle_player_logged_out( const PlayerLoggedOut& );
+
+    Player::Container& m_players;
+    TimingWheel m_wheel;
+    const BeforeUpdating m_before_updating;
+};
+
+}
+
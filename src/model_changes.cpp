@@ -0,0 +1,124 @@
+#include "model_changes.hpp"
+#include "fnv.hpp"
+#include "json.hpp"
+
+#include <algorithm>
+
+namespace
+{
+
+using EntryCallback = std::function< void( const std::string& path, const yarrrs::json::Slice& ) >;
+
+void
+for_each_entry( const std::string& model, const EntryCallback& callback )
+{
+  yarrrs::json::for_each_member( model, yarrrs::json::Slice{ 0, model.size() },
+      [ &model, &callback ]( const std::string& key, const yarrrs::json::Slice& value )
+      {
+        const bool is_object( yarrrs::json::for_each_member( model, value,
+              [ &key, &callback ]( const std::string& member, const yarrrs::json::Slice& member_value )
+              {
+                callback( key + "." + member, member_value );
+              } ) );
+
+        if ( !is_object )
+        {
+          callback( key, value );
+        }
+      } );
+}
+
+uint64_t
+hash_of( const std::string& model, const yarrrs::json::Slice& slice )
+{
+  return yarrrs::fnv1a( model.data() + slice.begin, slice.end - slice.begin );
+}
+
+}
+
+namespace yarrrs
+{
+
+ModelChanges::ModelChanges( size_t versions_kept )
+  : m_versions_kept( std::max< size_t >( 1, versions_kept ) )
+{
+}
+
+void
+ModelChanges::add( const ModelSnapshot::Snapshot& snapshot )
+{
+  Index index;
+  for_each_entry( snapshot.json,
+      [ &snapshot, &index ]( const std::string& path, const json::Slice& value )
+      {
+        index.emplace( path, hash_of( snapshot.json, value ) );
+      } );
+
+  m_indices.emplace_back( snapshot.version, std::move( index ) );
+  while ( m_indices.size() > m_versions_kept )
+  {
+    m_indices.pop_front();
+  }
+}
+
+bool
+ModelChanges::for_each_change_since(
+    uint64_t version,
+    const ModelSnapshot::Snapshot& current,
+    const ChangeCallback& callback ) const
+{
+  const auto known( std::find_if( std::begin( m_indices ), std::end( m_indices ),
+        [ version ]( const std::pair< uint64_t, Index >& index ) { return index.first == version; } ) );
+  const bool is_known( known != std::end( m_indices ) );
+
+  Index remaining( is_known ? known->second : Index() );
+  for_each_entry( current.json,
+      [ &current, &callback, &remaining ]( const std::string& path, const json::Slice& value )
+      {
+        const auto old( remaining.find( path ) );
+        const bool is_unchanged( old != std::end( remaining ) && old->second == hash_of( current.json, value ) );
+        if ( old != std::end( remaining ) )
+        {
+          remaining.erase( old );
+        }
+
+        if ( !is_unchanged )
+        {
+          callback( path, &value );
+        }
+      } );
+
+  for ( const auto& removed : remaining )
+  {
+    callback( removed.first, nullptr );
+  }
+
+  return is_known;
+}
+
+std::string
+ModelChanges::since( uint64_t version, const ModelSnapshot::Snapshot& current ) const
+{
+  std::string changed;
+  std::string removed;
+  const bool is_known( for_each_change_since( version, current,
+        [ &current, &changed, &removed ]( const std::string& path, const json::Slice* value )
+        {
+          if ( !value )
+          {
+            removed += ( removed.empty() ? "" : "," ) + json::quoted( path );
+            return;
+          }
+
+          changed += ( changed.empty() ? "" : "," ) + json::quoted( path ) + ":";
+          changed.append( current.json, value->begin, value->end - value->begin );
+        } ) );
+
+  return
+    "{\"version\":" + std::to_string( current.version ) +
+    ( is_known ? ",\"full\":false" : ",\"full\":true" ) +
+    ",\"changed\":{" + changed + "},\"removed\":[" + removed + "]}";
+}
+
+}
+
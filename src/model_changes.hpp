@@ -0,0 +1,49 @@
+#pragma once
+
+#include "json.hpp"
+#include "model_snapshot.hpp"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace yarrrs
+{
+
+//Remembers the entries of the last few model snapshots by their hash, so a
+//reader holding an older version is sent only the entries changed since then.
+//An entry is a member of a top level object of the model, e.g. one exported
+//object or one mission context, named by its dot separated path.  A top level
+//value that is not an object is an entry of its own.
+class ModelChanges
+{
+  public:
+    //value is null for a removed entry
+    using ChangeCallback = std::function< void( const std::string& path, const json::Slice* value ) >;
+
+    ModelChanges( size_t versions_kept );
+
+    void add( const ModelSnapshot::Snapshot& );
+
+    //{"version":5,"full":false,"changed":{"objects.12":{...}},"removed":["objects.7"]}
+    //every entry is sent as changed with full set to true when the version
+    //is not remembered, the reader drops what it had then
+    std::string since( uint64_t version, const ModelSnapshot::Snapshot& current ) const;
+
+    //calls back with every entry when the version is not remembered and
+    //returns false then
+    bool for_each_change_since(
+        uint64_t version,
+        const ModelSnapshot::Snapshot& current,
+        const ChangeCallback& ) const;
+
+  private:
+    using Index = std::unordered_map< std::string, uint64_t >;
+
+    const size_t m_versions_kept;
+    std::deque< std::pair< uint64_t, Index > > m_indices;
+};
+
+}
+
@@ -0,0 +1,103 @@
+#include "model_feed.hpp"
+
+namespace
+{
+
+bool
+starts_with( const std::string& text, const std::string& prefix )
+{
+  return text.compare( 0, prefix.size(), prefix ) == 0;
+}
+
+}
+
+namespace yarrrs
+{
+
+ModelFeed::ModelFeed()
+  : m_changes( 1 )
+  , m_last_version( 0 )
+{
+}
+
+void
+ModelFeed::subscribe( const std::string& topic )
+{
+  m_topics.insert( topic );
+  m_new_topics.insert( topic );
+}
+
+void
+ModelFeed::unsubscribe( const std::string& topic )
+{
+  m_topics.erase( topic );
+  m_new_topics.erase( topic );
+}
+
+bool
+ModelFeed::has_subscribers() const
+{
+  return !m_topics.empty();
+}
+
+void
+ModelFeed::publish( const ModelSnapshot::Snapshot& snapshot, const Sender& sender )
+{
+  bool is_everything_sent( false );
+  if ( snapshot.version != m_last_version )
+  {
+    is_everything_sent = !m_changes.for_each_change_since( m_last_version, snapshot,
+        [ this, &snapshot, &sender ]( const std::string& path, const json::Slice* value )
+        {
+          send_matching( m_topics, snapshot, path, value, sender );
+        } );
+    m_changes.add( snapshot );
+    m_last_version = snapshot.version;
+  }
+
+  if ( !is_everything_sent && !m_new_topics.empty() )
+  {
+    m_changes.for_each_change_since( 0, snapshot,
+        [ this, &snapshot, &sender ]( const std::string& path, const json::Slice* value )
+        {
+          send_matching( m_new_topics, snapshot, path, value, sender );
+        } );
+  }
+
+  m_new_topics.clear();
+}
+
+void
+ModelFeed::send_matching(
+    const std::set< std::string >& topics,
+    const ModelSnapshot::Snapshot& snapshot,
+    const std::string& path,
+    const json::Slice* value,
+    const Sender& sender ) const
+{
+  bool is_entry_sent( false );
+  for ( const auto& topic : topics )
+  {
+    if ( starts_with( path, topic ) )
+    {
+      if ( !is_entry_sent )
+      {
+        sender( path, value );
+        is_entry_sent = true;
+      }
+      continue;
+    }
+
+    if ( !starts_with( topic, path + "." ) )
+    {
+      continue;
+    }
+
+    json::Slice deeper;
+    const bool is_found( value && json::find( snapshot.json, topic, deeper ) );
+    sender( topic, is_found ? &deeper : nullptr );
+  }
+}
+
+}
+
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "json.hpp"
+#include "model_changes.hpp"
+#include "model_snapshot.hpp"
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+
+namespace yarrrs
+{
+
+//Decides what a change feed of the model publishes to its subscribers.  A
+//topic is a dot separated path, like a zmq subscription it matches every
+//entry of the model (see ModelChanges) whose path starts with it.  A topic
+//deeper than an entry, e.g. "objects.12.x", is published with its own value
+//whenever its entry changes.  A new topic is sent all of its entries once,
+//after that only the entries changed since the previous publish.
+class ModelFeed
+{
+  public:
+    //value is null for a removed entry
+    using Sender = std::function< void( const std::string& path, const json::Slice* value ) >;
+
+    ModelFeed();
+
+    void subscribe( const std::string& topic );
+    void unsubscribe( const std::string& topic );
+    bool has_subscribers() const;
+
+    void publish( const ModelSnapshot::Snapshot&, const Sender& );
+
+  private:
+    void send_matching(
+        const std::set< std::string >& topics,
+        const ModelSnapshot::Snapshot&,
+        const std::string& path,
+        const json::Slice* value,
+        const Sender& ) const;
+
+    ModelChanges m_changes;
+    uint64_t m_last_version;
+    std::set< std::string > m_topics;
+    std::set< std::string > m_new_topics;
+};
+
+}
+
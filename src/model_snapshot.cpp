@@ -0,0 +1,113 @@
+#include "model_snapshot.hpp"
+#include "configuration.hpp"
+
+#include <thectci/service_registry.hpp>
+#include <algorithm>
+
+namespace yarrrs
+{
+
+ModelSnapshot::Clock::duration
+ModelSnapshot::max_age_from_configuration()
+{
+  return std::chrono::milliseconds( configured_or< int64_t >( "remote_model_max_age", 1000 ) );
+}
+
+ModelSnapshot::ModelSnapshot( Exporter exporter, Clock::duration max_age )
+  : m_export( std::move( exporter ) )
+  , m_max_age( max_age )
+  , m_version( 0 )
+  , m_is_requested( false )
+  , m_is_stopped( false )
+  , m_snapshots( the::ctci::service< Metrics >().counter(
+        "yarrr_model_snapshots_total", "Model snapshots exported for remote readers." ) )
+  , m_export_seconds( the::ctci::service< Metrics >().counter(
+        "yarrr_model_snapshot_seconds_total", "Time the main thread spent on exporting model snapshots." ) )
+{
+}
+
+bool
+ModelSnapshot::is_fresh( Clock::time_point now ) const
+{
+  return m_snapshot && now - m_taken <= m_max_age;
+}
+
+ModelSnapshot::Pointer
+ModelSnapshot::get( Clock::duration timeout )
+{
+  std::unique_lock< std::mutex > lock( m_mutex );
+  const Clock::time_point asked( Clock::now() );
+  if ( !m_is_stopped && is_fresh( asked ) )
+  {
+    return m_snapshot;
+  }
+
+  return wait_for_snapshot_taken_since( lock, asked, timeout );
+}
+
+ModelSnapshot::Pointer
+ModelSnapshot::get_taken_since( Clock::time_point since, Clock::duration timeout )
+{
+  std::unique_lock< std::mutex > lock( m_mutex );
+  if ( !m_is_stopped && m_snapshot && m_taken >= since )
+  {
+    return m_snapshot;
+  }
+
+  return wait_for_snapshot_taken_since( lock, since, timeout );
+}
+
+ModelSnapshot::Pointer
+ModelSnapshot::wait_for_snapshot_taken_since(
+    std::unique_lock< std::mutex >& lock,
+    Clock::time_point since,
+    Clock::duration timeout )
+{
+  m_is_requested = true;
+  m_last_request = std::max( m_last_request, since );
+  const bool is_published( m_published.wait_for( lock, timeout,
+        [ this, since ]() { return m_is_stopped || ( m_snapshot && m_taken >= since ); } ) );
+  return is_published && !m_is_stopped ? m_snapshot : nullptr;
+}
+
+void
+ModelSnapshot::publish_if_requested()
+{
+  {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    if ( !m_is_requested )
+    {
+      return;
+    }
+  }
+
+  const Clock::time_point started( Clock::now() );
+  Pointer snapshot( std::make_shared< const Snapshot >( Snapshot{ m_version + 1, m_export() } ) );
+  m_snapshots.increment();
+  m_export_seconds.increment( std::chrono::duration< double >( Clock::now() - started ).count() );
+
+  {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_snapshot = std::move( snapshot );
+    m_version = m_snapshot->version;
+    m_taken = started;
+    //a request arriving during the export waits for the next one
+    m_is_requested = m_last_request > started;
+  }
+
+  m_published.notify_all();
+}
+
+void
+ModelSnapshot::stop()
+{
+  {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_is_stopped = true;
+  }
+
+  m_published.notify_all();
+}
+
+}
+
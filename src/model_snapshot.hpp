@@ -0,0 +1,68 @@
+#pragma once
+
+#include "metrics.hpp"
+#include <chrono>
+#include <cstdint>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace yarrrs
+{
+
+//An exported copy of the model handed from the main thread to readers on
+//other threads.  A reader asks for a snapshot not older than the maximum age;
+//when there is none, the main thread exports one in publish_if_requested at
+//the end of its tick, so a tick pays for at most one export, and only while
+//somebody is waiting.  Snapshots are immutable and shared by all readers.
+class ModelSnapshot
+{
+  public:
+    class Snapshot
+    {
+      public:
+        //counts the published snapshots from one
+        uint64_t version;
+        std::string json;
+    };
+
+    using Pointer = std::shared_ptr< const Snapshot >;
+    using Exporter = std::function< std::string() >;
+    using Clock = std::chrono::steady_clock;
+
+    static Clock::duration max_age_from_configuration();
+
+    ModelSnapshot( Exporter, Clock::duration max_age );
+
+    //any thread, empty when no snapshot is published until the timeout
+    Pointer get( Clock::duration timeout );
+    //any thread, like get but the snapshot is taken at or after the given time
+    //point however fresh the last one is, e.g. after the model was changed
+    Pointer get_taken_since( Clock::time_point, Clock::duration timeout );
+    //main thread
+    void publish_if_requested();
+    //wakes the waiting readers, get returns empty afterwards
+    void stop();
+
+  private:
+    bool is_fresh( Clock::time_point now ) const;
+    Pointer wait_for_snapshot_taken_since( std::unique_lock< std::mutex >&, Clock::time_point, Clock::duration timeout );
+
+    const Exporter m_export;
+    const Clock::duration m_max_age;
+    std::mutex m_mutex;
+    std::condition_variable m_published;
+    Pointer m_snapshot;
+    Clock::time_point m_taken;
+    Clock::time_point m_last_request;
+    uint64_t m_version;
+    bool m_is_requested;
+    bool m_is_stopped;
+    Metrics::Value& m_snapshots;
+    Metrics::Value& m_export_seconds;
+};
+
+}
+
@@ -21,6 +21,11 @@ NetworkService::NetworkService( the::time::Clock& clock )
   , m_network_service(
       std::bind( &NetworkService::handle_new_connection, this, std::placeholders::_1 ),
       std::bind( &NetworkService::handle_connection_lost, this, std::placeholders::_1 ) )
+  , m_connections( the::ctci::service< Metrics >().gauge(
+        "yarrr_connections", "Open client connections." ) )
+  , m_dropped_connections( the::ctci::service< Metrics >().counter(
+        "yarrr_dropped_connections_total", "Connections dropped by the server." ) )
+  , m_are_logins_paused( false )
 {
   m_network_service.listen_on( the::conf::get<int>( "port" ) );
   m_network_service.start();
@@ -45,10 +50,13 @@ void
 NetworkService::handle_new_connection_on_main_thread( the::net::Connection::Pointer connection )
 {
   thelog_trace( yarrr::log::info, __PRETTY_FUNCTION__ );
-  ConnectionBundle::Pointer new_connection_bundle( new ConnectionBundle( connection ) );
+  ConnectionBundle::Pointer new_connection_bundle( new ConnectionBundle(
+        connection,
+        [ this ]() { return !m_are_logins_paused; } ) );
   m_connection_bundles.emplace(
       connection->id,
       std::move( new_connection_bundle ) );
+  update_connection_metrics();
 }
 
 void
@@ -64,6 +72,35 @@ NetworkService::handle_connection_lost_on_main_thread( int connection_id )
 {
   thelog_trace( yarrr::log::info, __PRETTY_FUNCTION__ );
   m_connection_bundles.erase( connection_id );
+  update_connection_metrics();
+}
+
+void
+NetworkService::drop_connection( int connection_id )
+{
+  thelog( yarrr::log::info )( "Dropping connection", connection_id );
+  //logs the player out, nothing is queued or sent for the connection any more;
+  //thenet has no call to close a socket, it closes it when the client goes away
+  m_connection_bundles.erase( connection_id );
+  m_dropped_connections.increment();
+  update_connection_metrics();
+}
+
+void
+NetworkService::pause_logins( bool are_paused )
+{
+  if ( m_are_logins_paused != are_paused )
+  {
+    thelog( yarrr::log::info )( are_paused ? "Pausing logins." : "Resuming logins." );
+  }
+
+  m_are_logins_paused = are_paused;
+}
+
+void
+NetworkService::update_connection_metrics()
+{
+  m_connections.set( m_connection_bundles.size() );
 }
 
 void
@@ -2,6 +2,7 @@
 
 #include "login_handler.hpp"
 #include "local_event_dispatcher.hpp"
+#include "metrics.hpp"
 #include <yarrr/db.hpp>
 #include <thectci/dispatcher.hpp>
 #include <thenet/service.hpp>
@@ -26,11 +27,14 @@ class ConnectionBundle
 {
   public:
     typedef std::unique_ptr< ConnectionBundle > Pointer;
-    ConnectionBundle( the::net::Connection::Pointer connection )
+    ConnectionBundle(
+        the::net::Connection::Pointer connection,
+        LoginHandler::AdmissionCheck is_admitting = LoginHandler::AdmissionCheck() )
       : connection_wrapper( connection )
       , login_handler(
           connection_wrapper,
-          the::ctci::service< LocalEventDispatcher >().dispatcher )
+          the::ctci::service< LocalEventDispatcher >().dispatcher,
+          std::move( is_admitting ) )
     {
     }
 
@@ -43,17 +47,23 @@ class NetworkService
   public:
     NetworkService( the::time::Clock& clock );
     void process_network_events();
+    void drop_connection( int connection_id );
+    void pause_logins( bool are_paused );
 
   private:
     void handle_new_connection( the::net::Connection::Pointer connection );
     void handle_new_connection_on_main_thread( the::net::Connection::Pointer connection );
     void handle_connection_lost( the::net::Connection::Pointer connection );
     void handle_connection_lost_on_main_thread( int connection_id );
+    void update_connection_metrics();
 
     the::time::Clock& m_clock;
     the::net::Service m_network_service;
     yarrr::CallbackQueue m_callback_queue;
     std::unordered_map< int, ConnectionBundle::Pointer > m_connection_bundles;
+    Metrics::Value& m_connections;
+    Metrics::Value& m_dropped_connections;
+    bool m_are_logins_paused;
 };
 
 }
@@ -0,0 +1,54 @@
+#include "object_command_buffer.hpp"
+
+#include <yarrr/object_container.hpp>
+#include <algorithm>
+
+namespace yarrrs
+{
+
+void
+ObjectCommandBuffer::add( yarrr::Object::Pointer&& object )
+{
+  m_added.emplace_back( std::move( object ) );
+}
+
+void
+ObjectCommandBuffer::remove( yarrr::Object::Id id )
+{
+  m_deleted.push_back( id );
+}
+
+bool
+ObjectCommandBuffer::empty() const
+{
+  return m_added.empty() && m_deleted.empty();
+}
+
+void
+ObjectCommandBuffer::apply_to( yarrr::ObjectContainer& objects, const DeleteListener& deleted )
+{
+  m_adding.swap( m_added );
+  m_deleting.swap( m_deleted );
+
+  for ( auto& object : m_adding )
+  {
+    objects.add_object( std::move( object ) );
+  }
+  m_adding.clear();
+
+  std::sort( std::begin( m_deleting ), std::end( m_deleting ) );
+  m_deleting.erase( std::unique( std::begin( m_deleting ), std::end( m_deleting ) ), std::end( m_deleting ) );
+  if ( !m_deleting.empty() )
+  {
+    deleted( m_deleting );
+  }
+
+  for ( const auto id : m_deleting )
+  {
+    objects.delete_object( id );
+  }
+  m_deleting.clear();
+}
+
+}
+
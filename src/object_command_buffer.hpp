@@ -0,0 +1,42 @@
+#pragma once
+
+#include <yarrr/object.hpp>
+#include <functional>
+#include <vector>
+
+namespace yarrr
+{
+
+class ObjectContainer;
+
+}
+
+namespace yarrrs
+{
+
+//Collects object additions and deletions until they can be applied to the
+//object container in one go.  Repeated deletions of the same id are applied
+//and reported only once, together with the other deletions of the batch.
+//Commands issued while a batch is being applied go to the next batch.
+//Buffers keep their capacity between batches.
+class ObjectCommandBuffer
+{
+  public:
+    using DeletedIds = std::vector< yarrr::Object::Id >;
+    using DeleteListener = std::function< void( const DeletedIds& ) >;
+
+    void add( yarrr::Object::Pointer&& object );
+    void remove( yarrr::Object::Id id );
+
+    bool empty() const;
+    void apply_to( yarrr::ObjectContainer&, const DeleteListener& );
+
+  private:
+    std::vector< yarrr::Object::Pointer > m_added;
+    DeletedIds m_deleted;
+    std::vector< yarrr::Object::Pointer > m_adding;
+    DeletedIds m_deleting;
+};
+
+}
+
@@ -0,0 +1,54 @@
+#include "object_position.hpp"
+#include "player.hpp"
+
+#include <yarrr/object_container.hpp>
+
+namespace yarrrs
+{
+
+const yarrr::PhysicalParameters*
+physical_parameters_of( const yarrr::ObjectContainer& objects, yarrr::Object::Id id )
+{
+  if ( !objects.has_object_with_id( id ) )
+  {
+    return nullptr;
+  }
+
+  const yarrr::Object& object( objects.object_with_id( id ) );
+  if ( !yarrr::has_component< yarrr::PhysicalBehavior >( object ) )
+  {
+    return nullptr;
+  }
+
+  return &yarrr::component_of< yarrr::PhysicalBehavior >( object ).physical_parameters;
+}
+
+bool
+position_of_object( const yarrr::ObjectContainer& objects, yarrr::Object::Id id, yarrr::Coordinate& position )
+{
+  const yarrr::PhysicalParameters* const physical_parameters( physical_parameters_of( objects, id ) );
+  if ( !physical_parameters )
+  {
+    return false;
+  }
+
+  position = physical_parameters->coordinate;
+  return true;
+}
+
+bool
+position_of_player( const Player& player, const yarrr::ObjectContainer& objects, yarrr::Coordinate& position )
+{
+  return player.has_object() && position_of_object( objects, player.object_id(), position );
+}
+
+bool
+is_within( const yarrr::Coordinate& a, const yarrr::Coordinate& b, int64_t radius )
+{
+  const double dx( double( a.x ) - double( b.x ) );
+  const double dy( double( a.y ) - double( b.y ) );
+  return dx * dx + dy * dy <= double( radius ) * double( radius );
+}
+
+}
+
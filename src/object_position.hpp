@@ -0,0 +1,24 @@
+#pragma once
+
+#include <yarrr/object.hpp>
+#include <yarrr/basic_behaviors.hpp>
+
+namespace yarrr
+{
+
+class ObjectContainer;
+
+}
+
+namespace yarrrs
+{
+
+class Player;
+
+const yarrr::PhysicalParameters* physical_parameters_of( const yarrr::ObjectContainer&, yarrr::Object::Id );
+bool position_of_object( const yarrr::ObjectContainer&, yarrr::Object::Id, yarrr::Coordinate& position );
+bool position_of_player( const Player&, const yarrr::ObjectContainer&, yarrr::Coordinate& position );
+bool is_within( const yarrr::Coordinate& a, const yarrr::Coordinate& b, int64_t radius );
+
+}
+
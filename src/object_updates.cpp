@@ -0,0 +1,241 @@
+#include "object_updates.hpp"
+#include "object_position.hpp"
+#include "configuration.hpp"
+#include "zones.hpp"
+
+#include <yarrr/object_container.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+class Recipient
+{
+  public:
+    yarrrs::Player* player;
+    bool has_position;
+    yarrr::Coordinate position;
+    bool is_compact;
+    yarrrs::Zones::Key zone;
+    std::vector< yarrr::Object::Id > left_objects;
+};
+
+std::vector< Recipient >
+recipients_of(
+    const yarrr::ObjectContainer& objects,
+    const yarrrs::Player::Container& players,
+    const yarrrs::Zones* zones )
+{
+  std::vector< Recipient > recipients;
+  recipients.reserve( players.size() );
+  for ( const auto& player : players )
+  {
+    Recipient recipient{
+      player.second.get(),
+      false,
+      yarrr::Coordinate(),
+      player.second->has_capability( yarrrs::Capabilities::compact_physics ),
+      yarrrs::Zones::Key(),
+      {} };
+    recipient.has_position = yarrrs::position_of_player( *player.second, objects, recipient.position );
+    if ( zones && recipient.has_position )
+    {
+      recipient.zone = zones->zone_of( recipient.position );
+    }
+    recipients.push_back( std::move( recipient ) );
+  }
+
+  return recipients;
+}
+
+double
+distance_between( const yarrr::Coordinate& a, const yarrr::Coordinate& b )
+{
+  return std::hypot( double( a.x ) - double( b.x ), double( a.y ) - double( b.y ) );
+}
+
+class Delivery
+{
+  public:
+    yarrrs::Player* player;
+    double priority;
+};
+
+using Deliveries = std::vector< Delivery >;
+
+void
+queue_for(
+    Deliveries::const_iterator first,
+    Deliveries::const_iterator last,
+    yarrr::Object::Id id,
+    yarrr::Data&& update )
+{
+  yarrrs::hand_out( first, last, std::move( update ),
+      [ id ]( const Delivery& delivery, yarrr::Data&& update )
+      {
+        delivery.player->queue_object_update( id, std::move( update ), delivery.priority );
+      } );
+}
+
+}
+
+namespace yarrrs
+{
+
+DistantUpdates
+DistantUpdates::from_configuration( int64_t tick )
+{
+  return DistantUpdates{
+    configured_or< int64_t >( "distant_update_radius", 500000 ),
+    std::max( 1, configured_or< int >( "distant_update_interval", 5 ) ),
+    tick };
+}
+
+UpdatePriorities
+UpdatePriorities::from_configuration()
+{
+  return UpdatePriorities{
+    configured_or< double >( "update_priority_own_ship", 100.0 ),
+    std::max< int64_t >( 1, configured_or< int64_t >( "update_priority_half_distance", 100000 ) ),
+    std::max< int64_t >( 1, configured_or< int64_t >( "update_priority_double_speed", 1000 ) ) };
+}
+
+std::vector< int >
+send_object_updates(
+    const yarrr::ObjectContainer& objects,
+    Player::Container& players,
+    const UpdatePriorities& priorities,
+    const CompactPhysics& compact_physics,
+    const DistantUpdates& distant_updates,
+    Zones* zones )
+{
+  const bool is_throttled( distant_updates.interval > 1 );
+  std::vector< Recipient > recipients( recipients_of( objects, players, zones ) );
+  std::vector< yarrr::ObjectUpdate::Pointer > object_updates( objects.generate_object_updates() );
+  if ( zones )
+  {
+    zones->assign( objects, object_updates );
+  }
+
+  //first decide who gets what, the full updates are serialized afterwards only
+  //if somebody needs them, on the worker threads when the world has zones
+  Deliveries full_deliveries;
+  std::vector< size_t > first_full_delivery_of;
+  first_full_delivery_of.reserve( object_updates.size() + 1 );
+  Deliveries compact_deliveries;
+  for ( const auto& update : object_updates )
+  {
+    first_full_delivery_of.push_back( full_deliveries.size() );
+    const yarrr::Object::Id id( update->id() );
+    Zones::Key object_zone;
+    const bool has_zone( zones && zones->zone_of_object( id, object_zone ) );
+    const bool is_due_for_everyone( !is_throttled ||
+        ( uint64_t( distant_updates.tick ) + id ) % uint64_t( distant_updates.interval ) == 0 );
+    const yarrr::PhysicalParameters* const physical_parameters( physical_parameters_of( objects, id ) );
+    const double speed_factor( physical_parameters ?
+        1.0 + distance_between( physical_parameters->velocity, yarrr::Coordinate() ) / priorities.double_priority_speed :
+        1.0 );
+
+    compact_deliveries.clear();
+    for ( auto& recipient : recipients )
+    {
+      double priority( speed_factor );
+      if ( recipient.has_position && recipient.player->object_id() == id )
+      {
+        priority = priorities.own_ship;
+      }
+      else if ( has_zone && recipient.has_position && !Zones::are_neighbors( recipient.zone, object_zone ) )
+      {
+        if ( recipient.player->is_showing_object( id ) )
+        {
+          recipient.left_objects.push_back( id );
+        }
+        continue;
+      }
+      else if ( physical_parameters && recipient.has_position )
+      {
+        const double distance( distance_between( recipient.position, physical_parameters->coordinate ) );
+        if ( !is_due_for_everyone && distance > distant_updates.radius )
+        {
+          continue;
+        }
+
+        priority *= priorities.half_priority_distance / ( priorities.half_priority_distance + distance );
+      }
+
+      if ( !physical_parameters )
+      {
+        full_deliveries.push_back( Delivery{ recipient.player, priority } );
+        continue;
+      }
+
+      const DeadReckoning::Update needed( recipient.player->object_update_needed(
+            id, *physical_parameters, distant_updates.tick ) );
+      if ( needed == DeadReckoning::not_needed )
+      {
+        continue;
+      }
+
+      //an unsent keyframe must not be replaced by a compact correction
+      const bool is_compact( recipient.is_compact &&
+          needed == DeadReckoning::correction &&
+          !recipient.player->has_queued_object_update( id ) );
+      ( is_compact ? compact_deliveries : full_deliveries ).push_back( Delivery{ recipient.player, priority } );
+    }
+
+    if ( !compact_deliveries.empty() )
+    {
+      queue_for(
+          std::begin( compact_deliveries ), std::end( compact_deliveries ),
+          id, compact_physics.encode( id, *physical_parameters ) );
+    }
+  }
+  first_full_delivery_of.push_back( full_deliveries.size() );
+
+  std::vector< bool > is_needed( object_updates.size() );
+  for ( size_t index( 0 ); index < object_updates.size(); ++index )
+  {
+    is_needed[ index ] = first_full_delivery_of[ index + 1 ] > first_full_delivery_of[ index ];
+  }
+
+  std::vector< yarrr::Data > serialized_updates( zones ?
+      zones->serialize( object_updates, is_needed ) :
+      std::vector< yarrr::Data >( object_updates.size() ) );
+  for ( size_t index( 0 ); index < object_updates.size(); ++index )
+  {
+    if ( !is_needed[ index ] )
+    {
+      continue;
+    }
+
+    queue_for(
+        std::begin( full_deliveries ) + first_full_delivery_of[ index ],
+        std::begin( full_deliveries ) + first_full_delivery_of[ index + 1 ],
+        object_updates[ index ]->id(),
+        zones ? std::move( serialized_updates[ index ] ) : object_updates[ index ]->serialize() );
+  }
+
+  for ( const auto& recipient : recipients )
+  {
+    if ( !recipient.left_objects.empty() )
+    {
+      recipient.player->stop_showing_objects( recipient.left_objects );
+    }
+  }
+
+  std::vector< int > slow_players;
+  for ( const auto& player : players )
+  {
+    if ( !player.second->flush_object_updates() )
+    {
+      slow_players.push_back( player.first );
+    }
+  }
+
+  return slow_players;
+}
+
+}
+
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "player.hpp"
+#include "compact_physics.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace yarrr
+{
+
+class ObjectContainer;
+
+}
+
+namespace yarrrs
+{
+
+class Zones;
+
+//Objects farther than radius from the ship of a player are sent to that player
+//only in every interval-th tick.  An interval of one sends every update.  The
+//tick is the current one, it also times the dead reckoning keyframes.
+class DistantUpdates
+{
+  public:
+    static DistantUpdates from_configuration( int64_t tick );
+
+    int64_t radius;
+    int interval;
+    int64_t tick;
+};
+
+//Weights of the priority an object update gets for one player.  An object at
+//half_priority_distance from the ship of the player gets half the priority of
+//a nearby one, an object at double_priority_speed gets twice the priority of a
+//still one, and the own ship of the player gets own_ship.
+class UpdatePriorities
+{
+  public:
+    static UpdatePriorities from_configuration();
+
+    double own_ship;
+    int64_t half_priority_distance;
+    int64_t double_priority_speed;
+};
+
+//Queues the updates of every object for every player and flushes the queues.
+//With zones a player gets only the objects of the zones around its ship, and
+//objects leaving those zones are deleted on its client.
+//Returns the ids of the players who were unable to keep up.
+std::vector< int > send_object_updates(
+    const yarrr::ObjectContainer&,
+    Player::Container&,
+    const UpdatePriorities&,
+    const CompactPhysics&,
+    const DistantUpdates& distant_updates = DistantUpdates{ 0, 1, 0 },
+    Zones* zones = nullptr );
+
+}
+
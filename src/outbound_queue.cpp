@@ -0,0 +1,233 @@
+#include "outbound_queue.hpp"
+#include "configuration.hpp"
+
+#include <yarrr/log.hpp>
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace
+{
+
+yarrrs::OutboundQueue::Policy
+policy_from( const std::string& name )
+{
+  if ( name == "degrade" )
+  {
+    return yarrrs::OutboundQueue::degrade;
+  }
+
+  if ( name == "disconnect" )
+  {
+    return yarrrs::OutboundQueue::disconnect;
+  }
+
+  if ( name != "drop_stale" )
+  {
+    thelog( yarrr::log::warning )( "Unknown slow client policy:", name, "falling back to drop_stale." );
+  }
+
+  return yarrrs::OutboundQueue::drop_stale;
+}
+
+}
+
+namespace yarrrs
+{
+
+const int
+OutboundQueue::max_update_interval( 8 );
+
+OutboundQueue::Limits
+OutboundQueue::Limits::from_configuration()
+{
+  return Limits{
+    configured_or< size_t >( "outbound_bytes_per_tick", 64 * 1024 ),
+    configured_or< size_t >( "outbound_queue_limit", 256 * 1024 ),
+    policy_from( configured_or< std::string >( "slow_client_policy", "drop_stale" ) ),
+    configured_or< int >( "slow_client_grace_ticks", 50 ) };
+}
+
+OutboundQueue::OutboundQueue( const Limits& limits )
+  : m_limits( limits )
+  , m_queued_bytes( 0 )
+  , m_dropped_bytes( 0 )
+  , m_update_interval( 1 )
+  , m_ticks_since_flush( 0 )
+  , m_slow_ticks( 0 )
+  , m_bytes_sent_around( 0 )
+{
+}
+
+void
+OutboundQueue::push( yarrr::Object::Id id, yarrr::Data&& update, double priority )
+{
+  m_queued_bytes += update.size();
+  const auto index( m_index_of.find( id ) );
+  if ( index == m_index_of.end() )
+  {
+    m_index_of.emplace( id, m_updates.size() );
+    m_updates.push_back( Update{ id, std::move( update ), priority } );
+    return;
+  }
+
+  Update& stale_update( m_updates[ index->second ] );
+  m_queued_bytes -= stale_update.data.size();
+  m_dropped_bytes += stale_update.data.size();
+  stale_update.data = std::move( update );
+  stale_update.priority += priority;
+}
+
+bool
+OutboundQueue::flush( const Sender& send, size_t bytes_sent_around )
+{
+  m_bytes_sent_around += bytes_sent_around;
+  ++m_ticks_since_flush;
+  if ( m_ticks_since_flush < m_update_interval )
+  {
+    return true;
+  }
+
+  m_ticks_since_flush = 0;
+  const bool is_refused( !send_within_budget( send ) );
+  m_bytes_sent_around = 0;
+  return apply_policy( is_refused );
+}
+
+bool
+OutboundQueue::send_within_budget( const Sender& send )
+{
+  //stable, so updates of equal priority leave in the order they were queued
+  std::stable_sort( std::begin( m_updates ), std::end( m_updates ),
+      []( const Update& a, const Update& b )
+      {
+        return a.priority > b.priority;
+      } );
+
+  //an update bigger than the budget still goes out alone
+  size_t spent_bytes( m_bytes_sent_around );
+  size_t sent_bytes( 0 );
+  bool is_refused( false );
+  auto first_unsent( std::begin( m_updates ) );
+  for ( ; first_unsent != std::end( m_updates ); ++first_unsent )
+  {
+    const size_t size( first_unsent->data.size() );
+    if ( spent_bytes > 0 && spent_bytes + size > m_limits.bytes_per_tick )
+    {
+      break;
+    }
+
+    spent_bytes += size;
+    sent_bytes += size;
+    if ( !send( std::move( first_unsent->data ) ) )
+    {
+      //the refused update is gone, the client never gets it
+      m_dropped_bytes += size;
+      is_refused = true;
+      ++first_unsent;
+      break;
+    }
+  }
+
+  m_queued_bytes -= sent_bytes;
+  m_updates.erase( std::begin( m_updates ), first_unsent );
+  rebuild_index();
+  return !is_refused;
+}
+
+void
+OutboundQueue::remove( const std::vector< yarrr::Object::Id >& ids )
+{
+  std::unordered_set< yarrr::Object::Id > removed_ids;
+  for ( const auto id : ids )
+  {
+    const auto index( m_index_of.find( id ) );
+    if ( index != std::end( m_index_of ) )
+    {
+      m_queued_bytes -= m_updates[ index->second ].data.size();
+      removed_ids.insert( id );
+    }
+  }
+
+  if ( removed_ids.empty() )
+  {
+    return;
+  }
+
+  m_updates.erase(
+      std::remove_if( std::begin( m_updates ), std::end( m_updates ),
+        [ &removed_ids ]( const Update& update ) { return removed_ids.count( update.id ) > 0; } ),
+      std::end( m_updates ) );
+  rebuild_index();
+}
+
+void
+OutboundQueue::rebuild_index()
+{
+  m_index_of.clear();
+  for ( size_t i( 0 ); i < m_updates.size(); ++i )
+  {
+    m_index_of.emplace( m_updates[ i ].id, i );
+  }
+}
+
+bool
+OutboundQueue::apply_policy( bool is_refused )
+{
+  if ( !is_refused && m_queued_bytes <= m_limits.queue_limit )
+  {
+    m_slow_ticks = 0;
+    m_update_interval = std::max( 1, m_update_interval / 2 );
+    return true;
+  }
+
+  ++m_slow_ticks;
+  thelog( yarrr::log::debug )( "Outbound queue of a slow client:", m_queued_bytes, "bytes queued,",
+      is_refused ? "send refused," : "", "for", m_slow_ticks, "ticks." );
+
+  switch ( m_limits.policy )
+  {
+    case drop_stale:
+      m_dropped_bytes += m_queued_bytes;
+      m_queued_bytes = 0;
+      m_updates.clear();
+      m_index_of.clear();
+      return true;
+
+    case degrade:
+      m_update_interval = std::min( max_update_interval, m_update_interval * 2 );
+      return true;
+
+    case disconnect:
+      return m_slow_ticks <= m_limits.grace_ticks;
+  }
+
+  return true;
+}
+
+bool
+OutboundQueue::is_queued( yarrr::Object::Id id ) const
+{
+  return m_index_of.find( id ) != std::end( m_index_of );
+}
+
+size_t
+OutboundQueue::queued_bytes() const
+{
+  return m_queued_bytes;
+}
+
+size_t
+OutboundQueue::dropped_bytes() const
+{
+  return m_dropped_bytes;
+}
+
+int
+OutboundQueue::update_interval() const
+{
+  return m_update_interval;
+}
+
+}
+
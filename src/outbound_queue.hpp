@@ -0,0 +1,87 @@
+#pragma once
+
+#include <yarrr/object.hpp>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace yarrrs
+{
+
+//Holds the object updates of one connection that were not yet handed to the network.
+//Only the latest update of an object is kept, and only a limited number of bytes
+//is sent in one tick, counting the other messages of the connection too, the
+//rest is carried over to the next tick.
+//Every push adds to the priority of the object, the highest priorities are sent
+//first and a sent object starts again from zero, so nothing is starved for long.
+//A client is slow while its queue is over the limit or the connection refuses a
+//send.  The limit covers the queued updates only, thenet buffers whatever was
+//handed to it without a limit and tells nothing about its backlog.
+class OutboundQueue
+{
+  public:
+    enum Policy
+    {
+      drop_stale,
+      degrade,
+      //logs the player out, the socket stays open until the client closes it
+      disconnect
+    };
+
+    class Limits
+    {
+      public:
+        static Limits from_configuration();
+
+        size_t bytes_per_tick;
+        size_t queue_limit;
+        Policy policy;
+        int grace_ticks;
+    };
+
+    OutboundQueue( const Limits& );
+
+    void push( yarrr::Object::Id, yarrr::Data&& update, double priority = 1.0 );
+    void remove( const std::vector< yarrr::Object::Id >& ids );
+
+    //false when the connection refused the update
+    using Sender = std::function< bool( yarrr::Data&& ) >;
+    //returns false if the client could not keep up for longer than the grace period;
+    //bytes sent around the queue since the last flush take from the budget
+    bool flush( const Sender&, size_t bytes_sent_around = 0 );
+
+    bool is_queued( yarrr::Object::Id ) const;
+    size_t queued_bytes() const;
+    size_t dropped_bytes() const;
+    int update_interval() const;
+
+    static const int max_update_interval;
+
+  private:
+    //false when the connection refused an update
+    bool send_within_budget( const Sender& );
+    void rebuild_index();
+    bool apply_policy( bool is_refused );
+
+    class Update
+    {
+      public:
+        yarrr::Object::Id id;
+        yarrr::Data data;
+        double priority;
+    };
+
+    std::vector< Update > m_updates;
+    std::unordered_map< yarrr::Object::Id, size_t > m_index_of;
+
+    const Limits m_limits;
+    size_t m_queued_bytes;
+    size_t m_dropped_bytes;
+    int m_update_interval;
+    int m_ticks_since_flush;
+    int m_slow_ticks;
+    size_t m_bytes_sent_around;
+};
+
+}
+
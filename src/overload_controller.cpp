@@ -0,0 +1,82 @@
+#include "overload_controller.hpp"
+#include "configuration.hpp"
+
+#include <yarrr/log.hpp>
+
+namespace yarrrs
+{
+
+const char*
+OverloadController::name_of( Stage stage )
+{
+  switch ( stage )
+  {
+    case normal:
+      return "normal";
+    case distant_updates_throttled:
+      return "distant_updates_throttled";
+    case background_work_deferred:
+      return "background_work_deferred";
+    case logins_paused:
+      return "logins_paused";
+  }
+
+  return "unknown";
+}
+
+OverloadController::Limits
+OverloadController::Limits::from_configuration( Duration tick_budget )
+{
+  return Limits{
+    tick_budget,
+    configured_or< double >( "overload_raise_ratio", 0.9 ),
+    configured_or< double >( "overload_lower_ratio", 0.6 ),
+    configured_or< int >( "overload_heavy_ticks_to_raise", 3 ),
+    configured_or< int >( "overload_light_ticks_to_lower", 50 ) };
+}
+
+OverloadController::OverloadController( const Limits& limits )
+  : m_limits( limits )
+  , m_stage( normal )
+  , m_heavy_ticks( 0 )
+  , m_light_ticks( 0 )
+{
+}
+
+void
+OverloadController::record( Duration tick )
+{
+  const double load( double( tick.count() ) / m_limits.tick_budget.count() );
+  m_heavy_ticks = load >= m_limits.raise_ratio ? m_heavy_ticks + 1 : 0;
+  m_light_ticks = load <= m_limits.lower_ratio ? m_light_ticks + 1 : 0;
+
+  if ( m_heavy_ticks >= m_limits.heavy_ticks_to_raise && m_stage < logins_paused )
+  {
+    m_stage = Stage( m_stage + 1 );
+    m_heavy_ticks = 0;
+    thelog( yarrr::log::warning )( "Overloaded, shedding load:", name_of( m_stage ) );
+    return;
+  }
+
+  if ( m_light_ticks >= m_limits.light_ticks_to_lower && m_stage > normal )
+  {
+    m_stage = Stage( m_stage - 1 );
+    m_light_ticks = 0;
+    thelog( yarrr::log::info )( "Load dropped, restoring:", name_of( m_stage ) );
+  }
+}
+
+OverloadController::Stage
+OverloadController::stage() const
+{
+  return m_stage;
+}
+
+bool
+OverloadController::is_at_least( Stage stage ) const
+{
+  return m_stage >= stage;
+}
+
+}
+
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+
+namespace yarrrs
+{
+
+//Watches the work done in a tick and sheds load in stages when the ticks keep
+//running over the budget.  A stage is raised after a few heavy ticks in a row
+//and lowered only after a longer run of light ticks, so the server does not
+//flap between stages on a single spike.
+class OverloadController
+{
+  public:
+    using Duration = std::chrono::microseconds;
+
+    enum Stage
+    {
+      normal,
+      distant_updates_throttled,
+      background_work_deferred,
+      logins_paused
+    };
+
+    static const char* name_of( Stage );
+
+    class Limits
+    {
+      public:
+        static Limits from_configuration( Duration tick_budget );
+
+        Duration tick_budget;
+        double raise_ratio;
+        double lower_ratio;
+        int heavy_ticks_to_raise;
+        int light_ticks_to_lower;
+    };
+
+    OverloadController( const Limits& );
+
+    void record( Duration tick );
+    Stage stage() const;
+    bool is_at_least( Stage ) const;
+
+  private:
+    const Limits m_limits;
+    Stage m_stage;
+    int m_heavy_ticks;
+    int m_light_ticks;
+};
+
+}
+
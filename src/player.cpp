@@ -1,6 +1,8 @@
 #include "player.hpp"
 #include "command_handler.hpp"
 #include "network_service.hpp"
+#include "chat_router.hpp"
+#include "local_event_dispatcher.hpp"
 
 #include <yarrr/object.hpp>
 #include <yarrr/protocol.hpp>
@@ -8,14 +10,19 @@
 #include <yarrr/log.hpp>
 #include <yarrr/command.hpp>
 #include <yarrr/mission_exporter.hpp>
+#include <yarrr/delete_object.hpp>
 
 #include <yarrr/command.hpp>
 
 #include <thectci/service_registry.hpp>
 
+#include <algorithm>
+
 namespace
 {
 
+const std::string queued_bytes_metric( "yarrr_player_queued_bytes" );
+
 yarrr::Hash&
 assign_new_modell_if_needed_to( yarrr::Hash& player_model, const std::string& category )
 {
@@ -49,6 +56,41 @@ create_permanent_object_if_needed_for(  yarrr::Hash& character_model )
   return object_model;
 }
 
+yarrr::Data
+delete_list_of( const std::vector< yarrr::Object::Id >& ids )
+{
+  std::vector< std::string > parameters{ yarrrs::Capabilities::delete_list };
+  for ( const auto id : ids )
+  {
+    parameters.push_back( std::to_string( id ) );
+  }
+
+  return yarrr::Command( parameters ).serialize();
+}
+
+std::vector< yarrr::Data >
+delete_objects_of( const std::vector< yarrr::Object::Id >& ids )
+{
+  std::vector< yarrr::Data > delete_objects;
+  for ( const auto id : ids )
+  {
+    delete_objects.push_back( yarrr::DeleteObject( id ).serialize() );
+  }
+
+  return delete_objects;
+}
+
+template < typename Send >
+void
+hand_out_to( const yarrrs::Player::Container& players, yarrr::Data&& message, Send send )
+{
+  yarrrs::hand_out( std::begin( players ), std::end( players ), std::move( message ),
+      [ &send ]( const yarrrs::Player::Container::value_type& player, yarrr::Data&& message )
+      {
+        send( *player.second, std::move( message ) );
+      } );
+}
+
 }
 
 namespace yarrrs
@@ -58,7 +100,8 @@ Player::Player(
     const Container& players,
     const std::string& name,
     ConnectionWrapper& connection_wrapper,
-    const CommandHandler& command_handler )
+    const CommandHandler& command_handler,
+    const Capabilities& capabilities )
   : name( name )
   , m_players( players )
   , m_connection_wrapper( connection_wrapper )
@@ -70,6 +113,24 @@ Player::Player(
   , m_character_model( create_character_model_if_needed_for( m_player_model ) )
   , m_permanent_object_model( create_permanent_object_if_needed_for( m_character_model ) )
   , m_observers()
+  , m_changed_models()
+  , m_object_updates( OutboundQueue::Limits::from_configuration() )
+  , m_dead_reckoning( DeadReckoning::Tolerances::from_configuration() )
+  , m_capabilities( capabilities )
+  , m_compressor( m_capabilities.has( Capabilities::lz_compression ) ?
+      std::make_unique< Compressor >( Compressor::threshold_from_configuration() ) :
+      nullptr )
+  , m_sent_bytes( 0 )
+  , m_sent_bytes_at_flush( 0 )
+  , m_object_update_traffic( the::ctci::service< Metrics >(), "object_update" )
+  , m_model_traffic( the::ctci::service< Metrics >(), "model" )
+  , m_mission_traffic( the::ctci::service< Metrics >(), "mission" )
+  , m_other_traffic( the::ctci::service< Metrics >(), "other" )
+  , m_metric_labels(
+      Metrics::label( "player", name ) + "," +
+      Metrics::label( "connection", std::to_string( connection_wrapper.connection->id ) ) )
+  , m_queued_bytes( the::ctci::service< Metrics >().gauge(
+        queued_bytes_metric, "Object updates waiting for the network, per player.", m_metric_labels ) )
 {
   m_player_model[ yarrr::model::availability ] = "online";
   connection_wrapper.register_listener< yarrr::ChatMessage >(
@@ -84,7 +145,13 @@ Player::Player(
   auto hash_changed_observer(
     [ this ]( const yarrr::Hash& changed_hash )
     {
-      send( yarrr::ModellSerializer( changed_hash ).serialize() );
+      const bool was_already_changed( std::find(
+            std::begin( m_changed_models ), std::end( m_changed_models ),
+            &changed_hash ) != std::end( m_changed_models ) );
+      if ( !was_already_changed )
+      {
+        m_changed_models.push_back( &changed_hash );
+      }
     } );
 
   m_observers.emplace_back( m_player_model.auto_observe( hash_changed_observer ) );
@@ -95,45 +162,166 @@ Player::Player(
 void
 Player::synchronize_modells()
 {
-  send( yarrr::ModellSerializer( m_player_model ).serialize() );
-  send( yarrr::ModellSerializer( m_character_model ).serialize() );
-  send( yarrr::ModellSerializer( m_permanent_object_model ).serialize() );
+  send_as( yarrr::ModellSerializer( m_player_model ).serialize(), m_model_traffic );
+  send_as( yarrr::ModellSerializer( m_character_model ).serialize(), m_model_traffic );
+  send_as( yarrr::ModellSerializer( m_permanent_object_model ).serialize(), m_model_traffic );
+}
+
+void
+Player::flush_model_changes()
+{
+  for ( const auto& changed_model : m_changed_models )
+  {
+    send_as( yarrr::ModellSerializer( *changed_model ).serialize(), m_model_traffic );
+  }
+  m_changed_models.clear();
 }
 
 Player::~Player()
 {
   m_observers.clear();
   m_player_model[ yarrr::model::availability ] = "offline";
+  the::ctci::service< Metrics >().remove( queued_bytes_metric, m_metric_labels );
 }
 
 void
 Player::handle_command( const yarrr::Command& command )
 {
   const auto result( m_command_handler.execute( command, *this ) );
-  const bool did_succeed( std::get< 0 >( result ) );
-  if ( did_succeed )
+  if ( result.did_succeed() )
   {
     return;
   }
 
-  const std::string error_message( "Command failed: " + command.command() + " | " + std::get< 1 >( result ) );
+  const std::string error_message( "Command failed: " + command.command() + " | " + result.message() );
   send( yarrr::ChatMessage( error_message, "server" ).serialize() );
 }
 
+size_t
+Player::sent_bytes() const
+{
+  return m_sent_bytes;
+}
+
+bool
+Player::has_capability( const std::string& name ) const
+{
+  return m_capabilities.has( name );
+}
+
 bool
 Player::send( yarrr::Data&& message ) const
 {
-  return m_connection_wrapper.connection->send( std::move( message ) );
+  return send_as( std::move( message ), m_other_traffic );
+}
+
+bool
+Player::send_as( yarrr::Data&& message, const Traffic& traffic ) const
+{
+  yarrr::Data outgoing( m_compressor ?
+      m_compressor->compress_if_worth_it( std::move( message ) ) :
+      std::move( message ) );
+  m_sent_bytes += outgoing.size();
+  traffic.count( outgoing.size() );
+  return m_connection_wrapper.connection->send( std::move( outgoing ) );
 }
 
 void
-Player::handle_chat_message( const yarrr::ChatMessage& chat_message )
+Player::queue_object_update( yarrr::Object::Id id, yarrr::Data&& update, double priority )
+{
+  m_object_updates.push( id, std::move( update ), priority );
+  m_shown_objects.insert( id );
+}
+
+DeadReckoning::Update
+Player::object_update_needed(
+    yarrr::Object::Id id,
+    const yarrr::PhysicalParameters& physical_parameters,
+    int64_t tick )
+{
+  return m_dead_reckoning.update_needed( id, physical_parameters, tick );
+}
+
+bool
+Player::is_showing_object( yarrr::Object::Id id ) const
+{
+  return m_shown_objects.find( id ) != std::end( m_shown_objects );
+}
+
+void
+Player::forget_objects( const std::vector< yarrr::Object::Id >& ids )
+{
+  for ( const auto id : ids )
+  {
+    m_dead_reckoning.forget( id );
+    m_shown_objects.erase( id );
+  }
+
+  //a queued update would bring the object back on the client
+  m_object_updates.remove( ids );
+}
+
+void
+Player::stop_showing_objects( const std::vector< yarrr::Object::Id >& ids )
 {
-  const yarrr::Data message( chat_message.serialize() );
-  for ( const auto& player : m_players )
+  forget_objects( ids );
+  if ( has_capability( Capabilities::delete_list ) )
   {
-    player.second->send( yarrr::Data( message ) );
+    send( delete_list_of( ids ) );
+    return;
   }
+
+  for ( auto& delete_object : delete_objects_of( ids ) )
+  {
+    send( std::move( delete_object ) );
+  }
+}
+
+bool
+Player::flush_object_updates()
+{
+  const size_t dropped_bytes_before( m_object_updates.dropped_bytes() );
+  const bool is_keeping_up( m_object_updates.flush(
+      [ this ]( yarrr::Data&& update )
+      {
+        return send_as( std::move( update ), m_object_update_traffic );
+      },
+      m_sent_bytes - m_sent_bytes_at_flush ) );
+  m_sent_bytes_at_flush = m_sent_bytes;
+
+  //the client never got the dropped updates, so its extrapolations are unknown
+  if ( m_object_updates.dropped_bytes() != dropped_bytes_before )
+  {
+    m_dead_reckoning.forget_all();
+  }
+
+  m_queued_bytes.set( double( m_object_updates.queued_bytes() ) );
+
+  return is_keeping_up;
+}
+
+bool
+Player::has_queued_object_update( yarrr::Object::Id id ) const
+{
+  return m_object_updates.is_queued( id );
+}
+
+size_t
+Player::queued_bytes() const
+{
+  return m_object_updates.queued_bytes();
+}
+
+void
+Player::handle_chat_message( const yarrr::ChatMessage& chat_message )
+{
+  the::ctci::service< LocalEventDispatcher >().dispatcher.dispatch( ChatPosted( *this, chat_message ) );
+}
+
+bool
+Player::has_object() const
+{
+  return m_current_object != nullptr;
 }
 
 yarrr::Object::Id
@@ -153,6 +341,7 @@ Player::assign_object( yarrr::Object& object )
   m_current_object = &object;
   m_permanent_object_model[ yarrr::model::realtime_object_id ] = std::to_string( object.id() );
   send( yarrr::Command( { yarrr::Protocol::object_assigned, std::to_string( object.id() ) } ).serialize() );
+  m_shown_objects.insert( object.id() );
   thelog( yarrr::log::debug )( "Assigning object to user.", object.id(), name );
   m_connection_wrapper.register_dispatcher( object.dispatcher );
   refresh_mission_models();
@@ -195,28 +384,74 @@ Player::update_missions()
   m_missions.update();
   for ( const auto& mission : m_missions.missions() )
   {
-    send( mission->serialize() );
+    send_mission_if_changed( *mission );
   }
 }
 
+void
+Player::send_mission_if_changed( const yarrr::Mission& mission )
+{
+  yarrr::Data serialized_mission( mission.serialize() );
+  yarrr::Data& last_sent_state( m_last_sent_mission_states[ mission.id() ] );
+  if ( serialized_mission == last_sent_state )
+  {
+    return;
+  }
+
+  last_sent_state = serialized_mission;
+  send_as( std::move( serialized_mission ), m_mission_traffic );
+}
+
 void
 Player::handle_mission_finished( const yarrr::Mission& mission )
 {
-  send( mission.serialize() );
+  send_as( mission.serialize(), m_mission_traffic );
+  m_last_sent_mission_states.erase( mission.id() );
   m_own_mission_contexts.erase( mission.id() );
 }
 
 void
 broadcast( const Player::Container& players, const yarrr::Entity& entity )
 {
-  const yarrr::Data message( entity.serialize() );
+  broadcast( players, entity.serialize() );
+}
+
+void
+broadcast( const Player::Container& players, yarrr::Data&& message )
+{
+  hand_out_to( players, std::move( message ),
+      []( Player& player, yarrr::Data&& message )
+      {
+        player.send( std::move( message ) );
+      } );
+}
+
+void
+broadcast_object_update( const Player::Container& players, yarrr::Object::Id id, yarrr::Data&& update )
+{
+  hand_out_to( players, std::move( update ),
+      [ id ]( Player& player, yarrr::Data&& update )
+      {
+        player.queue_object_update( id, std::move( update ) );
+      } );
+}
+
+void
+broadcast_deleted_objects( const Player::Container& players, const std::vector< yarrr::Object::Id >& ids )
+{
   for ( const auto& player : players )
   {
-    player.second->send( yarrr::Data( message ) );
+    //the others never got an update of the objects
+    std::vector< yarrr::Object::Id > shown_ids;
+    std::copy_if( std::begin( ids ), std::end( ids ), std::back_inserter( shown_ids ),
+        [ &player ]( yarrr::Object::Id id ) { return player.second->is_showing_object( id ); } );
+    if ( !shown_ids.empty() )
+    {
+      player.second->stop_showing_objects( shown_ids );
+    }
   }
 }
 
-
 void
 Player::player_killed()
 {
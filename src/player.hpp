@@ -2,8 +2,15 @@
 
 #include "network_service.hpp"
 #include "models.hpp"
+#include "outbound_queue.hpp"
+#include "dead_reckoning.hpp"
+#include "capabilities.hpp"
+#include "compression.hpp"
+#include "metrics.hpp"
+#include <iterator>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <yarrr/mission.hpp>
 #include <yarrr/mission_container.hpp>
 #include <yarrr/mission_exporter.hpp>
@@ -33,7 +40,8 @@ class Player
         const Container&,
         const std::string& name,
         ConnectionWrapper& connection_wrapper,
-        const CommandHandler& );
+        const CommandHandler&,
+        const Capabilities& capabilities = Capabilities() );
 
     ~Player();
 
@@ -41,8 +49,25 @@ class Player
     Player& operator=( const Player& ) = delete;
 
     bool send( yarrr::Data&& message ) const;
+    size_t sent_bytes() const;
+    bool has_capability( const std::string& name ) const;
+
+    DeadReckoning::Update object_update_needed( yarrr::Object::Id, const yarrr::PhysicalParameters&, int64_t tick );
+    //an object is shown from its assignment or its first queued update until it
+    //is forgotten, whatever the dead reckoning of the player remembers about it
+    bool is_showing_object( yarrr::Object::Id ) const;
+    void forget_objects( const std::vector< yarrr::Object::Id >& ids );
+    //deletes the objects on the client, e.g. when they leave the zones it sees
+    void stop_showing_objects( const std::vector< yarrr::Object::Id >& ids );
+    void queue_object_update( yarrr::Object::Id, yarrr::Data&& update, double priority = 1.0 );
+    bool flush_object_updates();
+    bool has_queued_object_update( yarrr::Object::Id ) const;
+    size_t queued_bytes() const;
+
+    void flush_model_changes();
 
     const std::string name;
+    bool has_object() const;
     yarrr::Object::Id object_id() const;
     void assign_object( yarrr::Object& object );
 
@@ -57,6 +82,8 @@ class Player
     void handle_command( const yarrr::Command& );
     void handle_chat_message( const yarrr::ChatMessage& );
     void handle_mission_finished( const yarrr::Mission& );
+    void send_mission_if_changed( const yarrr::Mission& );
+    bool send_as( yarrr::Data&& message, const Traffic& ) const;
 
     const Container& m_players;
     ConnectionWrapper& m_connection_wrapper;
@@ -68,14 +95,48 @@ class Player
     using MissionModelContainer = std::unordered_map< yarrr::Mission::Id, std::unique_ptr< yarrr::MissionModel > >;
     MissionModelContainer m_own_mission_contexts;
 
+    using MissionStateContainer = std::unordered_map< yarrr::Mission::Id, yarrr::Data >;
+    MissionStateContainer m_last_sent_mission_states;
+
     yarrr::Hash& m_player_model;
     yarrr::Hash& m_character_model;
     yarrr::Hash& m_permanent_object_model;
 
     std::vector< yarrr::Hash::auto_observer_type > m_observers;
+    std::vector< const yarrr::Hash* > m_changed_models;
+    OutboundQueue m_object_updates;
+    DeadReckoning m_dead_reckoning;
+    std::unordered_set< yarrr::Object::Id > m_shown_objects;
+    const Capabilities m_capabilities;
+    std::unique_ptr< const Compressor > m_compressor;
+    mutable size_t m_sent_bytes;
+    //the messages sent since take from the budget of the object updates
+    size_t m_sent_bytes_at_flush;
+    const Traffic m_object_update_traffic;
+    const Traffic m_model_traffic;
+    const Traffic m_mission_traffic;
+    const Traffic m_other_traffic;
+    const std::string m_metric_labels;
+    Metrics::Value& m_queued_bytes;
 };
 
 void broadcast( const Player::Container& players, const yarrr::Entity& entity );
+void broadcast( const Player::Container& players, yarrr::Data&& message );
+void broadcast_object_update( const Player::Container& players, yarrr::Object::Id, yarrr::Data&& update );
+void broadcast_deleted_objects( const Player::Container& players, const std::vector< yarrr::Object::Id >& ids );
+
+//Calls send with each recipient and a message of its own.  The connections and
+//queues take ownership of the buffer, so every recipient but the last one gets
+//a copy, the last one gets the original.
+template < typename Iterator, typename Send >
+void
+hand_out( Iterator first, Iterator last, yarrr::Data&& message, Send send )
+{
+  for ( auto recipient( first ); recipient != last; ++recipient )
+  {
+    send( *recipient, std::next( recipient ) != last ? yarrr::Data( message ) : std::move( message ) );
+  }
+}
 
 }
 
@@ -0,0 +1,44 @@
+#include "rate_limiter.hpp"
+
+namespace yarrrs
+{
+
+RateLimiter::RateLimiter( int burst, int ticks_per_token )
+  : m_burst( burst )
+  , m_ticks_per_token( ticks_per_token )
+  , m_tokens( burst )
+  , m_ticks_since_last_token( 0 )
+{
+}
+
+bool
+RateLimiter::try_acquire()
+{
+  if ( m_tokens <= 0 )
+  {
+    return false;
+  }
+
+  --m_tokens;
+  return true;
+}
+
+void
+RateLimiter::tick()
+{
+  if ( m_tokens >= m_burst )
+  {
+    m_ticks_since_last_token = 0;
+    return;
+  }
+
+  ++m_ticks_since_last_token;
+  if ( m_ticks_since_last_token >= m_ticks_per_token )
+  {
+    m_ticks_since_last_token = 0;
+    ++m_tokens;
+  }
+}
+
+}
+
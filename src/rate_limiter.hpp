@@ -0,0 +1,24 @@
+#pragma once
+
+namespace yarrrs
+{
+
+//Token bucket counted in simulation ticks: holds at most burst tokens and
+//gains one every ticks_per_token ticks.
+class RateLimiter
+{
+  public:
+    RateLimiter( int burst, int ticks_per_token );
+
+    bool try_acquire();
+    void tick();
+
+  private:
+    const int m_burst;
+    const int m_ticks_per_token;
+    int m_tokens;
+    int m_ticks_since_last_token;
+};
+
+}
+
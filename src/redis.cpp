@@ -1,7 +1,10 @@
 #include "redis.hpp"
+#include "metrics.hpp"
 #include <yarrr/log.hpp>
 #include <theconf/configuration.hpp>
+#include <thectci/service_registry.hpp>
 #include <hiredis/hiredis.h>
+#include <chrono>
 #include <memory>
 #include <cassert>
 #include <unordered_map>
@@ -25,7 +28,8 @@ class RedisCommand
 {
   public:
     RedisCommand( std::string command )
-      : m_command( std::move( command ) )
+      : m_started( std::chrono::steady_clock::now() )
+      , m_command( std::move( command ) )
       , m_context( redisConnect(
             the::conf::get_value( "redis_ip" ).c_str(),
             the::conf::get< int >( "redis_port" ) ),
@@ -35,6 +39,7 @@ class RedisCommand
       //todo: only one connection should exist for all commands
       assert( m_context.get() != nullptr );
       assert( !m_context->err );
+      count_in_metrics();
 
       if ( !is_ok() )
       {
@@ -118,6 +123,13 @@ class RedisCommand
     }
 
   private:
+    void count_in_metrics() const
+    {
+      const std::chrono::duration< double > duration( std::chrono::steady_clock::now() - m_started );
+      yarrrs::count_redis_command( m_command.substr( 0, m_command.find( ' ' ) ), duration.count(), is_ok() );
+    }
+
+    const std::chrono::steady_clock::time_point m_started;
     std::string m_command;
     std::unique_ptr< redisContext, decltype( free_context ) > m_context;
     std::unique_ptr< redisReply, decltype( free_reply ) > m_reply;
@@ -144,6 +156,20 @@ array_command( const std::string& command, yarrr::Db::Values& values )
 namespace yarrrs
 {
 
+void
+count_redis_command( const std::string& command, double seconds, bool is_ok )
+{
+  const std::string labels( Metrics::label( "command", command ) );
+  auto& metrics( the::ctci::service< Metrics >() );
+  metrics.counter( "yarrr_redis_commands_total", "Redis commands executed.", labels ).increment();
+  metrics.counter( "yarrr_redis_command_seconds_total",
+      "Time spent on redis commands including connecting.", labels ).increment( seconds );
+  if ( !is_ok )
+  {
+    metrics.counter( "yarrr_redis_errors_total", "Redis commands finished with error.", labels ).increment();
+  }
+}
+
 bool
 RedisDb::set_hash_field(
     const std::string& key,
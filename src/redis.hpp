@@ -5,6 +5,9 @@
 namespace yarrrs
 {
 
+//counts a command in the redis metrics, for every redis client of the server
+void count_redis_command( const std::string& command, double seconds, bool is_ok );
+
 class RedisDb : public yarrr::Db
 {
   public:
@@ -0,0 +1,219 @@
+#include "redis_cluster_store.hpp"
+#include "redis.hpp"
+#include <yarrr/log.hpp>
+#include <theconf/configuration.hpp>
+#include <hiredis/hiredis.h>
+#include <chrono>
+#include <sys/time.h>
+
+namespace
+{
+
+const timeval command_timeout{ 0, 200 * 1000 };
+
+std::string
+name_of( const std::vector< std::string >& arguments )
+{
+  return arguments.empty() ? std::string() : arguments.front();
+}
+
+bool
+is_acquired( const redisReply* reply )
+{
+  return
+    reply &&
+    reply->type == REDIS_REPLY_INTEGER &&
+    reply->integer == 1;
+}
+
+bool
+string_of( const redisReply* reply, std::string& value )
+{
+  if ( !reply || reply->type != REDIS_REPLY_STRING )
+  {
+    return false;
+  }
+
+  value.assign( reply->str, reply->len );
+  return true;
+}
+
+}
+
+namespace yarrrs
+{
+
+const std::string
+RedisClusterStore::acquire_lease_script(
+    "local owner = redis.call( 'get', KEYS[ 1 ] ) "
+    "if owner == false or owner == ARGV[ 1 ] then "
+    "  redis.call( 'set', KEYS[ 1 ], ARGV[ 1 ], 'px', ARGV[ 2 ] ) "
+    "  return 1 "
+    "end "
+    "return 0" );
+
+const std::string
+RedisClusterStore::release_lease_script(
+    "if redis.call( 'get', KEYS[ 1 ] ) == ARGV[ 1 ] then "
+    "  return redis.call( 'del', KEYS[ 1 ] ) "
+    "end "
+    "return 0" );
+
+const std::string
+RedisClusterStore::take_script(
+    "local value = redis.call( 'get', KEYS[ 1 ] ) "
+    "redis.call( 'del', KEYS[ 1 ] ) "
+    "return value" );
+
+RedisClusterStore::RedisClusterStore()
+  : m_context( nullptr, redisFree )
+{
+}
+
+bool
+RedisClusterStore::is_connected()
+{
+  if ( m_context && !m_context->err )
+  {
+    return true;
+  }
+
+  m_context.reset( redisConnectWithTimeout(
+        the::conf::get_value( "redis_ip" ).c_str(),
+        the::conf::get< int >( "redis_port" ),
+        command_timeout ) );
+  if ( !m_context || m_context->err )
+  {
+    thelog( yarrr::log::error )( "Unable to connect to redis:", m_context ? m_context->errstr : "out of memory" );
+    m_context.reset();
+    return false;
+  }
+
+  redisSetTimeout( m_context.get(), command_timeout );
+  return true;
+}
+
+RedisClusterStore::Reply
+RedisClusterStore::execute( const Arguments& arguments )
+{
+  std::vector< Reply > replies( execute_pipelined( { arguments } ) );
+  return std::move( replies.front() );
+}
+
+//arguments are passed as they are, so they may contain spaces, e.g. lua scripts
+std::vector< RedisClusterStore::Reply >
+RedisClusterStore::execute_pipelined( const std::vector< Arguments >& commands )
+{
+  std::vector< Reply > replies;
+  if ( commands.empty() )
+  {
+    return replies;
+  }
+
+  const auto started( std::chrono::steady_clock::now() );
+  bool is_sent( is_connected() );
+  for ( const auto& arguments : commands )
+  {
+    std::vector< const char* > values;
+    std::vector< size_t > lengths;
+    for ( const auto& argument : arguments )
+    {
+      values.push_back( argument.data() );
+      lengths.push_back( argument.size() );
+    }
+
+    is_sent = is_sent && redisAppendCommandArgv(
+        m_context.get(), int( arguments.size() ), values.data(), lengths.data() ) == REDIS_OK;
+  }
+
+  for ( const auto& arguments : commands )
+  {
+    void* received( nullptr );
+    is_sent = is_sent && redisGetReply( m_context.get(), &received ) == REDIS_OK;
+    Reply reply( is_sent ? static_cast< redisReply* >( received ) : nullptr, freeReplyObject );
+    if ( !reply )
+    {
+      thelog( yarrr::log::error )( "Redis command failed:", name_of( arguments ),
+          m_context ? m_context->errstr : "not connected" );
+    }
+    else if ( reply->type == REDIS_REPLY_ERROR )
+    {
+      thelog( yarrr::log::error )( "Redis command finished with error:", reply->str, "command:", name_of( arguments ) );
+      reply.reset();
+    }
+
+    replies.push_back( std::move( reply ) );
+  }
+
+  const std::chrono::duration< double > duration( std::chrono::steady_clock::now() - started );
+  for ( size_t i( 0 ); i < commands.size(); ++i )
+  {
+    count_redis_command( name_of( commands[ i ] ), duration.count() / commands.size(), replies[ i ] != nullptr );
+  }
+
+  return replies;
+}
+
+bool
+RedisClusterStore::acquire(
+    const std::string& key,
+    const std::string& owner,
+    int64_t lease_milliseconds )
+{
+  return is_acquired( execute( {
+      "eval", acquire_lease_script, "1", key, owner, std::to_string( lease_milliseconds ) } ).get() );
+}
+
+
+std::vector< bool >
+RedisClusterStore::acquire_all(
+    const std::vector< std::string >& keys,
+    const std::string& owner,
+    int64_t lease_milliseconds )
+{
+  std::vector< Arguments > commands;
+  for ( const auto& key : keys )
+  {
+    commands.push_back( { "eval", acquire_lease_script, "1", key, owner, std::to_string( lease_milliseconds ) } );
+  }
+
+  std::vector< bool > acquired;
+  for ( const auto& reply : execute_pipelined( commands ) )
+  {
+    acquired.push_back( is_acquired( reply.get() ) );
+  }
+
+  return acquired;
+}
+
+
+void
+RedisClusterStore::release( const std::string& key, const std::string& owner )
+{
+  execute( { "eval", release_lease_script, "1", key, owner } );
+}
+
+
+bool
+RedisClusterStore::get( const std::string& key, std::string& value )
+{
+  return string_of( execute( { "get", key } ).get(), value );
+}
+
+
+void
+RedisClusterStore::put( const std::string& key, const std::string& value, int64_t lease_milliseconds )
+{
+  execute( { "set", key, value, "px", std::to_string( lease_milliseconds ) } );
+}
+
+
+bool
+RedisClusterStore::take( const std::string& key, std::string& value )
+{
+  return string_of( execute( { "eval", take_script, "1", key } ).get(), value );
+}
+
+
+}
+
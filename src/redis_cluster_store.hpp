@@ -0,0 +1,69 @@
+#pragma once
+#include "cluster.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+struct redisContext;
+struct redisReply;
+
+namespace yarrrs
+{
+
+//Keeps the leases of the cluster in Redis.  Every command goes through one
+//connection, opened by the first command and again by the first one after a
+//failure.  A command waits for Redis a short while only, so a Redis that went
+//away delays the tick a little instead of stopping it.
+class RedisClusterStore : public Cluster::Store
+{
+  public:
+    //leases are plain keys holding the name of the owner, they expire unless renewed
+    static const std::string acquire_lease_script;
+    static const std::string release_lease_script;
+    static const std::string take_script;
+
+    RedisClusterStore();
+
+    virtual bool acquire(
+        const std::string& key,
+        const std::string& owner,
+        int64_t lease_milliseconds ) override;
+
+    //pipelined, the renewals of a tick take one round trip
+    virtual std::vector< bool > acquire_all(
+        const std::vector< std::string >& keys,
+        const std::string& owner,
+        int64_t lease_milliseconds ) override;
+
+    virtual void release(
+        const std::string& key,
+        const std::string& owner ) override;
+
+    virtual bool get(
+        const std::string& key,
+        std::string& value ) override;
+
+    virtual void put(
+        const std::string& key,
+        const std::string& value,
+        int64_t lease_milliseconds ) override;
+
+    virtual bool take(
+        const std::string& key,
+        std::string& value ) override;
+
+  private:
+    using Arguments = std::vector< std::string >;
+    using Reply = std::unique_ptr< redisReply, void(*)( void* ) >;
+
+    //null when the command failed
+    Reply execute( const Arguments& );
+    //the replies in the order of the commands
+    std::vector< Reply > execute_pipelined( const std::vector< Arguments >& );
+    bool is_connected();
+
+    std::unique_ptr< redisContext, void(*)( redisContext* ) > m_context;
+};
+
+}
+
@@ -0,0 +1,125 @@
+#include "remote_model_feed.hpp"
+#include "configuration.hpp"
+
+#include <yarrr/log.hpp>
+#include <zmq.h>
+
+namespace
+{
+
+const std::chrono::seconds snapshot_timeout( 5 );
+const char subscribe( 1 );
+const char unsubscribe( 0 );
+
+}
+
+namespace yarrrs
+{
+
+ModelSnapshot::Clock::duration
+RemoteModelFeed::interval_from_configuration()
+{
+  return std::chrono::milliseconds( configured_or< int64_t >( "remote_model_feed_interval", 500 ) );
+}
+
+RemoteModelFeed::RemoteModelFeed(
+    const std::string& endpoint,
+    ModelSnapshot& snapshot,
+    ModelSnapshot::Clock::duration interval )
+  : m_snapshot( snapshot )
+  , m_interval( interval )
+  , m_next_publish( ModelSnapshot::Clock::now() )
+  , m_endpoint( ZMQ_XPUB )
+{
+  //every subscriber of a topic is told about it, so each of them is sent
+  //the entries of its topic in full when it joins
+  const int verbose( 1 );
+  zmq_setsockopt( m_endpoint.socket(), ZMQ_XPUB_VERBOSE, &verbose, sizeof( verbose ) );
+  if ( !m_endpoint.bind( endpoint ) )
+  {
+    return;
+  }
+
+  thelog( yarrr::log::info )( "Publishing model changes on", endpoint );
+  m_endpoint.start(
+      [ this ]() { receive_subscriptions(); },
+      [ this ]() { publish_when_due(); } );
+}
+
+RemoteModelFeed::~RemoteModelFeed()
+{
+  m_snapshot.stop();
+  m_endpoint.stop();
+}
+
+bool
+RemoteModelFeed::is_listening() const
+{
+  return m_endpoint.is_running();
+}
+
+void
+RemoteModelFeed::publish_when_due()
+{
+  const ModelSnapshot::Clock::time_point now( ModelSnapshot::Clock::now() );
+  if ( now < m_next_publish || !m_feed.has_subscribers() )
+  {
+    return;
+  }
+
+  m_next_publish = now + m_interval;
+  publish();
+}
+
+void
+RemoteModelFeed::receive_subscriptions()
+{
+  zmq_msg_t message;
+  zmq_msg_init( &message );
+  while ( zmq_msg_recv( &message, m_endpoint.socket(), ZMQ_DONTWAIT ) >= 0 )
+  {
+    const char* const data( static_cast< const char* >( zmq_msg_data( &message ) ) );
+    const size_t size( zmq_msg_size( &message ) );
+    if ( size > 0 && data[ 0 ] == subscribe )
+    {
+      m_feed.subscribe( std::string( data + 1, size - 1 ) );
+    }
+    else if ( size > 0 && data[ 0 ] == unsubscribe )
+    {
+      m_feed.unsubscribe( std::string( data + 1, size - 1 ) );
+    }
+  }
+
+  zmq_msg_close( &message );
+}
+
+void
+RemoteModelFeed::publish()
+{
+  const ModelSnapshot::Pointer snapshot( m_snapshot.get( snapshot_timeout ) );
+  if ( !snapshot )
+  {
+    return;
+  }
+
+  m_feed.publish( *snapshot,
+      [ this, &snapshot ]( const std::string& path, const json::Slice* value )
+      {
+        if ( !m_endpoint.send( path.data(), path.size(), ZMQ_SNDMORE ) )
+        {
+          return;
+        }
+
+        if ( value )
+        {
+          m_endpoint.send( snapshot->json.data() + value->begin, value->end - value->begin, 0 );
+        }
+        else
+        {
+          m_endpoint.send( nullptr, 0, 0 );
+        }
+      } );
+}
+
+}
+
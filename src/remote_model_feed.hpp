@@ -0,0 +1,44 @@
+#pragma once
+
+#include "model_feed.hpp"
+#include "model_snapshot.hpp"
+#include "zmq_endpoint.hpp"
+#include <string>
+
+namespace yarrrs
+{
+
+//Publishes the changes of the model on a zmq XPUB socket, so remote tools
+//subscribe to the paths they watch instead of polling the whole model.  Every
+//message has two frames, the path and the json value at it, the value is empty
+//when the path was removed.  Changes are published at most once per interval,
+//from snapshots shared with the other readers, so a snapshot younger than the
+//maximum age is published again as no change.  The model is only exported
+//while somebody is subscribed.
+class RemoteModelFeed
+{
+  public:
+    static ModelSnapshot::Clock::duration interval_from_configuration();
+
+    RemoteModelFeed( const std::string& endpoint, ModelSnapshot&, ModelSnapshot::Clock::duration interval );
+    ~RemoteModelFeed();
+
+    RemoteModelFeed( const RemoteModelFeed& ) = delete;
+    RemoteModelFeed& operator=( const RemoteModelFeed& ) = delete;
+
+    bool is_listening() const;
+
+  private:
+    void receive_subscriptions();
+    void publish_when_due();
+    void publish();
+
+    ModelSnapshot& m_snapshot;
+    const ModelSnapshot::Clock::duration m_interval;
+    ModelSnapshot::Clock::time_point m_next_publish;
+    ModelFeed m_feed;
+    ZmqEndpoint m_endpoint;
+};
+
+}
+
@@ -0,0 +1,165 @@
+#include "remote_model_server.hpp"
+#include "configuration.hpp"
+#include "json.hpp"
+
+#include <yarrr/log.hpp>
+#include <yarrr/main_thread_callback_queue.hpp>
+#include <thectci/service_registry.hpp>
+#include <zmq.h>
+
+#include <cstdlib>
+#include <future>
+
+namespace
+{
+
+const std::chrono::seconds snapshot_timeout( 5 );
+const std::string no_snapshot( "{\"error\":\"no snapshot of the model was published in time\"}" );
+const std::string not_executed( "{\"error\":\"the main thread did not run the request in time\"}" );
+const std::string no_such_path( "{\"error\":\"no such path in the model\"}" );
+const std::string changes_request( "changes " );
+const std::string exec_request( "exec " );
+
+//zmq keeps the snapshot alive while it sends a slice of it
+void
+release_snapshot( void*, void* snapshot )
+{
+  delete static_cast< yarrrs::ModelSnapshot::Pointer* >( snapshot );
+}
+
+}
+
+namespace yarrrs
+{
+
+RemoteModelServer::RemoteModelServer( const std::string& endpoint, ModelSnapshot& snapshot, Executor executor )
+  : m_snapshot( snapshot )
+  , m_execute( std::move( executor ) )
+  , m_changes( configured_or< size_t >( "remote_model_versions_kept", 16 ) )
+  , m_last_indexed_version( 0 )
+  , m_endpoint( ZMQ_REP )
+{
+  if ( !m_endpoint.bind( endpoint ) )
+  {
+    return;
+  }
+
+  thelog( yarrr::log::info )( "Serving model snapshots on", endpoint );
+  m_endpoint.start( [ this ]() { answer(); } );
+}
+
+RemoteModelServer::~RemoteModelServer()
+{
+  m_snapshot.stop();
+  m_endpoint.stop();
+}
+
+bool
+RemoteModelServer::is_listening() const
+{
+  return m_endpoint.is_running();
+}
+
+void
+RemoteModelServer::answer()
+{
+  zmq_msg_t message;
+  zmq_msg_init( &message );
+  const bool is_received( zmq_msg_recv( &message, m_endpoint.socket(), 0 ) >= 0 );
+  const std::string request( is_received ?
+      std::string( static_cast< const char* >( zmq_msg_data( &message ) ), zmq_msg_size( &message ) ) :
+      std::string() );
+  zmq_msg_close( &message );
+  if ( !is_received )
+  {
+    return;
+  }
+
+  const bool is_exec( request.compare( 0, exec_request.size(), exec_request ) == 0 );
+  ModelSnapshot::Clock::time_point executed;
+  if ( is_exec && !execute( request.substr( exec_request.size() ), executed ) )
+  {
+    send( not_executed );
+    return;
+  }
+
+  const ModelSnapshot::Pointer snapshot( is_exec ?
+      m_snapshot.get_taken_since( executed, snapshot_timeout ) :
+      m_snapshot.get( snapshot_timeout ) );
+  if ( !snapshot )
+  {
+    send( no_snapshot );
+    return;
+  }
+
+  if ( snapshot->version != m_last_indexed_version )
+  {
+    m_changes.add( *snapshot );
+    m_last_indexed_version = snapshot->version;
+  }
+
+  if ( request.compare( 0, changes_request.size(), changes_request ) == 0 )
+  {
+    const uint64_t version( std::strtoull( request.c_str() + changes_request.size(), nullptr, 10 ) );
+    send( m_changes.since( version, *snapshot ) );
+    return;
+  }
+
+  send_slice_of( snapshot, is_exec ? std::string() : request );
+}
+
+bool
+RemoteModelServer::execute( const std::string& code, ModelSnapshot::Clock::time_point& executed )
+{
+  thelog( yarrr::log::info )( "Running remote model request:", code );
+  //the callback may run after the request timed out, even after the server is gone
+  const auto finished( std::make_shared< std::promise< ModelSnapshot::Clock::time_point > >() );
+  std::future< ModelSnapshot::Clock::time_point > is_finished( finished->get_future() );
+  the::ctci::service< yarrr::MainThreadCallbackQueue >().push_back(
+      [ execute = m_execute, finished, code ]()
+      {
+        execute( code );
+        finished->set_value( ModelSnapshot::Clock::now() );
+      } );
+
+  if ( is_finished.wait_for( snapshot_timeout ) != std::future_status::ready )
+  {
+    return false;
+  }
+
+  executed = is_finished.get();
+  return true;
+}
+
+void
+RemoteModelServer::send_slice_of( const ModelSnapshot::Pointer& snapshot, const std::string& path )
+{
+  json::Slice slice;
+  if ( !json::find( snapshot->json, path, slice ) )
+  {
+    send( no_such_path );
+    return;
+  }
+
+  zmq_msg_t reply;
+  zmq_msg_init_data(
+      &reply,
+      const_cast< char* >( snapshot->json.data() ) + slice.begin,
+      slice.end - slice.begin,
+      release_snapshot,
+      new ModelSnapshot::Pointer( snapshot ) );
+  if ( zmq_msg_send( &reply, m_endpoint.socket(), 0 ) < 0 )
+  {
+    m_endpoint.log_send_failure();
+    zmq_msg_close( &reply );
+  }
+}
+
+void
+RemoteModelServer::send( const std::string& reply )
+{
+  m_endpoint.send( reply.data(), reply.size(), 0 );
+}
+
+}
+
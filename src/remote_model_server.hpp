@@ -0,0 +1,51 @@
+#pragma once
+
+#include "model_changes.hpp"
+#include "model_snapshot.hpp"
+#include "zmq_endpoint.hpp"
+#include <functional>
+#include <string>
+
+namespace yarrrs
+{
+
+//Answers the requests of the remote model endpoint from json snapshots of the
+//model.  Requests are served on a thread of its own, a slow reader waits for a
+//snapshot there instead of delaying the tick.  A request is either
+//  a dot separated path, answered with the value at that path, the empty
+//  path is the whole model,
+//  or "changes <version>", answered with the entries changed since the
+//  snapshot of that version, see ModelChanges,
+//  or "exec <code>", run against the live model on the main thread between
+//  two ticks and answered with the whole model of a snapshot taken after it.
+//Values are sent straight from the shared snapshot without copying.
+class RemoteModelServer
+{
+  public:
+    //runs on the main thread
+    using Executor = std::function< void( const std::string& code ) >;
+
+    RemoteModelServer( const std::string& endpoint, ModelSnapshot&, Executor );
+    ~RemoteModelServer();
+
+    RemoteModelServer( const RemoteModelServer& ) = delete;
+    RemoteModelServer& operator=( const RemoteModelServer& ) = delete;
+
+    bool is_listening() const;
+
+  private:
+    void answer();
+    //false when the main thread did not run the code in time
+    bool execute( const std::string& code, ModelSnapshot::Clock::time_point& executed );
+    void send_slice_of( const ModelSnapshot::Pointer&, const std::string& path );
+    void send( const std::string& reply );
+
+    ModelSnapshot& m_snapshot;
+    const Executor m_execute;
+    ModelChanges m_changes;
+    uint64_t m_last_indexed_version;
+    ZmqEndpoint m_endpoint;
+};
+
+}
+
@@ -7,6 +7,7 @@
 
 #include "dummy_particle_factory.hpp"
 #include "local_event_dispatcher.hpp"
+#include "metrics.hpp"
 
 namespace
 {
@@ -30,5 +31,8 @@ namespace
 
   the::ctci::AutoServiceRegister< yarrr::ParticleFactory, DummyParticleFactory >
     auto_particle_factory_register;
+
+  the::ctci::AutoServiceRegister< yarrrs::Metrics, yarrrs::Metrics >
+    auto_metrics_register;
 }
 
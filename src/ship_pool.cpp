@@ -0,0 +1,79 @@
+#include "ship_pool.hpp"
+#include "configuration.hpp"
+
+#include <yarrr/object_factory.hpp>
+#include <yarrr/log.hpp>
+
+namespace yarrrs
+{
+
+ShipPool::ShipPool( yarrr::ObjectFactory& factory, size_t spares_per_type )
+  : m_factory( factory )
+  , m_spares_per_type( spares_per_type )
+{
+}
+
+size_t
+ShipPool::spares_per_type_from_configuration()
+{
+  return configured_or< size_t >( "ship_pool_spares", 4 );
+}
+
+void
+ShipPool::keep_spares_of( const std::string& type )
+{
+  m_spares[ type ].reserve( m_spares_per_type );
+}
+
+yarrr::Object::Pointer
+ShipPool::acquire( const std::string& type )
+{
+  const auto spares( m_spares.find( type ) );
+  if ( spares == std::end( m_spares ) || spares->second.empty() )
+  {
+    yarrr::Object::Pointer ship( m_factory.create_a( type ) );
+    if ( ship && m_spares_per_type > 0 )
+    {
+      keep_spares_of( type );
+    }
+    return ship;
+  }
+
+  yarrr::Object::Pointer ship( std::move( spares->second.back() ) );
+  spares->second.pop_back();
+  return ship;
+}
+
+void
+ShipPool::refill( size_t budget )
+{
+  for ( auto spares( std::begin( m_spares ) ); spares != std::end( m_spares ) && budget > 0; )
+  {
+    if ( spares->second.size() >= m_spares_per_type )
+    {
+      ++spares;
+      continue;
+    }
+
+    yarrr::Object::Pointer ship( m_factory.create_a( spares->first ) );
+    if ( !ship )
+    {
+      thelog( yarrr::log::warning )( "Unable to build spare ship, dropping type from the pool:", spares->first );
+      spares = m_spares.erase( spares );
+      continue;
+    }
+
+    spares->second.push_back( std::move( ship ) );
+    --budget;
+  }
+}
+
+size_t
+ShipPool::spares_of( const std::string& type ) const
+{
+  const auto spares( m_spares.find( type ) );
+  return spares == std::end( m_spares ) ? 0 : spares->second.size();
+}
+
+}
+
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <yarrr/object.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace yarrr
+{
+
+class ObjectFactory;
+
+}
+
+namespace yarrrs
+{
+
+//Keeps ships of the used types built ahead of time, so respawns and ship
+//requests take a ready object instead of running the factory in the middle
+//of a busy tick.  Spares are built by refill, a few per tick.
+class ShipPool
+{
+  public:
+    ShipPool( yarrr::ObjectFactory&, size_t spares_per_type );
+
+    static size_t spares_per_type_from_configuration();
+
+    void keep_spares_of( const std::string& type );
+    yarrr::Object::Pointer acquire( const std::string& type );
+    void refill( size_t budget );
+
+    size_t spares_of( const std::string& type ) const;
+
+  private:
+    using Spares = std::vector< yarrr::Object::Pointer >;
+
+    yarrr::ObjectFactory& m_factory;
+    const size_t m_spares_per_type;
+    std::unordered_map< std::string, Spares > m_spares;
+};
+
+}
+
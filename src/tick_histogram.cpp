@@ -0,0 +1,79 @@
+#include "tick_histogram.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace yarrrs
+{
+
+TickHistogram::TickHistogram( Duration bucket_width, size_t number_of_buckets )
+  : m_bucket_width( bucket_width )
+  , m_buckets( number_of_buckets + 1, 0 )
+  , m_count( 0 )
+  , m_max( 0 )
+{
+}
+
+void
+TickHistogram::record( Duration duration )
+{
+  const size_t bucket( std::min< size_t >(
+        std::max< Duration::rep >( 0, duration.count() ) / m_bucket_width.count(),
+        m_buckets.size() - 1 ) );
+  ++m_buckets[ bucket ];
+  ++m_count;
+  m_max = std::max( m_max, duration );
+}
+
+void
+TickHistogram::reset()
+{
+  std::fill( std::begin( m_buckets ), std::end( m_buckets ), 0 );
+  m_count = 0;
+  m_max = Duration( 0 );
+}
+
+size_t
+TickHistogram::count() const
+{
+  return m_count;
+}
+
+TickHistogram::Duration
+TickHistogram::max() const
+{
+  return m_max;
+}
+
+TickHistogram::Duration
+TickHistogram::percentile( double percent ) const
+{
+  const double wanted( m_count * percent / 100.0 );
+  size_t seen( 0 );
+  for ( size_t bucket( 0 ); bucket < m_buckets.size() - 1; ++bucket )
+  {
+    seen += m_buckets[ bucket ];
+    if ( seen > 0 && seen >= wanted )
+    {
+      return std::min( m_max, m_bucket_width * static_cast< Duration::rep >( bucket + 1 ) );
+    }
+  }
+
+  return m_max;
+}
+
+std::string
+TickHistogram::summary() const
+{
+  std::stringstream summary;
+  summary
+    << "ticks: " << m_count
+    << " p50: " << percentile( 50 ).count() << "us"
+    << " p90: " << percentile( 90 ).count() << "us"
+    << " p99: " << percentile( 99 ).count() << "us"
+    << " max: " << m_max.count() << "us";
+  return summary.str();
+}
+
+}
+
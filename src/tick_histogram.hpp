@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace yarrrs
+{
+
+//Fixed width bucket histogram of tick durations.  Durations beyond the last
+//bucket are counted in an overflow bucket, the maximum is tracked exactly.
+class TickHistogram
+{
+  public:
+    using Duration = std::chrono::microseconds;
+
+    TickHistogram( Duration bucket_width, size_t number_of_buckets );
+
+    void record( Duration );
+    void reset();
+
+    size_t count() const;
+    Duration max() const;
+    //upper bound of the bucket holding the given percentile
+    Duration percentile( double ) const;
+    std::string summary() const;
+
+  private:
+    const Duration m_bucket_width;
+    std::vector< size_t > m_buckets;
+    size_t m_count;
+    Duration m_max;
+};
+
+}
+
@@ -0,0 +1,71 @@
+#include "timing_wheel.hpp"
+
+#include <algorithm>
+
+namespace yarrrs
+{
+
+TimingWheel::TimingWheel( size_t number_of_slots )
+  : m_slots( std::max< size_t >( 1, number_of_slots ) )
+  , m_current_slot( 0 )
+{
+}
+
+void
+TimingWheel::add( Key key )
+{
+  if ( m_slot_of.find( key ) != std::end( m_slot_of ) )
+  {
+    return;
+  }
+
+  const auto least_loaded( std::min_element(
+        std::begin( m_slots ), std::end( m_slots ),
+        []( const std::vector< Key >& left, const std::vector< Key >& right )
+        {
+          return left.size() < right.size();
+        } ) );
+
+  least_loaded->push_back( key );
+  m_slot_of.emplace( key, std::distance( std::begin( m_slots ), least_loaded ) );
+}
+
+void
+TimingWheel::remove( Key key )
+{
+  const auto slot_of_key( m_slot_of.find( key ) );
+  if ( slot_of_key == std::end( m_slot_of ) )
+  {
+    return;
+  }
+
+  auto& slot( m_slots[ slot_of_key->second ] );
+  slot.erase( std::remove( std::begin( slot ), std::end( slot ), key ), std::end( slot ) );
+  m_slot_of.erase( slot_of_key );
+}
+
+void
+TimingWheel::tick( const Callback& callback )
+{
+  for ( const auto& key : m_slots[ m_current_slot ] )
+  {
+    callback( key );
+  }
+
+  m_current_slot = ( m_current_slot + 1 ) % m_slots.size();
+}
+
+size_t
+TimingWheel::size() const
+{
+  return m_slot_of.size();
+}
+
+size_t
+TimingWheel::size_of_slot( size_t slot ) const
+{
+  return m_slots.at( slot ).size();
+}
+
+}
+
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace yarrrs
+{
+
+//Spreads periodic work evenly over the ticks of a period.  Every key is placed
+//in the least loaded slot, and each tick visits the keys of one slot only.
+class TimingWheel
+{
+  public:
+    using Key = int;
+    using Callback = std::function< void( Key ) >;
+
+    TimingWheel( size_t number_of_slots );
+
+    void add( Key );
+    void remove( Key );
+
+    //the callback must not add or remove keys
+    void tick( const Callback& );
+
+    size_t size() const;
+    size_t size_of_slot( size_t slot ) const;
+
+  private:
+    std::vector< std::vector< Key > > m_slots;
+    std::unordered_map< Key, size_t > m_slot_of;
+    size_t m_current_slot;
+};
+
+}
+
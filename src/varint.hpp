@@ -0,0 +1,53 @@
+#pragma once
+
+#include <yarrr/object.hpp>
+#include <cstdint>
+
+namespace yarrrs
+{
+
+//Unsigned integers in little endian groups of seven bits, the high bit of a
+//byte tells that another byte follows.
+inline void
+write_varint( yarrr::Data& output, uint64_t value )
+{
+  while ( value >= 0x80 )
+  {
+    output.push_back( static_cast< char >( ( value & 0x7f ) | 0x80 ) );
+    value >>= 7;
+  }
+  output.push_back( static_cast< char >( value ) );
+}
+
+inline bool
+read_varint( const yarrr::Data& input, size_t& position, uint64_t& value )
+{
+  value = 0;
+  for ( size_t shift( 0 ); shift < 64 && position < input.size(); shift += 7 )
+  {
+    const uint8_t byte( input[ position++ ] );
+    value |= uint64_t( byte & 0x7f ) << shift;
+    if ( !( byte & 0x80 ) )
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//Maps signed integers to unsigned ones so small negative numbers stay short as varints.
+inline uint64_t
+zigzag( int64_t value )
+{
+  return ( uint64_t( value ) << 1 ) ^ uint64_t( value >> 63 );
+}
+
+inline int64_t
+unzigzag( uint64_t value )
+{
+  return int64_t( value >> 1 ) ^ -int64_t( value & 1 );
+}
+
+}
+
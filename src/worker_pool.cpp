@@ -0,0 +1,112 @@
+#include "worker_pool.hpp"
+#include "configuration.hpp"
+
+#include <algorithm>
+
+namespace yarrrs
+{
+
+size_t
+WorkerPool::threads_from_configuration()
+{
+  const size_t cores( std::max( 1u, std::thread::hardware_concurrency() ) );
+  return configured_or< size_t >( "worker_threads", cores - 1 );
+}
+
+WorkerPool::WorkerPool( size_t threads )
+  : m_tasks( nullptr )
+  , m_next_task( 0 )
+  , m_unfinished_tasks( 0 )
+  , m_is_stopping( false )
+{
+  for ( size_t i( 0 ); i < threads; ++i )
+  {
+    m_threads.emplace_back( &WorkerPool::work, this );
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_is_stopping = true;
+  }
+
+  m_batch_started.notify_all();
+  for ( auto& thread : m_threads )
+  {
+    thread.join();
+  }
+}
+
+size_t
+WorkerPool::size() const
+{
+  return m_threads.size();
+}
+
+bool
+WorkerPool::run_next_task( std::unique_lock< std::mutex >& lock )
+{
+  if ( !m_tasks || m_next_task >= m_tasks->size() )
+  {
+    return false;
+  }
+
+  const Task& task( ( *m_tasks )[ m_next_task++ ] );
+  lock.unlock();
+  task();
+  lock.lock();
+
+  --m_unfinished_tasks;
+  if ( m_unfinished_tasks == 0 )
+  {
+    m_batch_finished.notify_all();
+  }
+
+  return true;
+}
+
+void
+WorkerPool::work()
+{
+  std::unique_lock< std::mutex > lock( m_mutex );
+  while ( true )
+  {
+    m_batch_started.wait( lock,
+        [ this ]() { return m_is_stopping || ( m_tasks && m_next_task < m_tasks->size() ); } );
+    if ( m_is_stopping )
+    {
+      return;
+    }
+
+    while ( run_next_task( lock ) )
+    {
+    }
+  }
+}
+
+void
+WorkerPool::run( const std::vector< Task >& tasks )
+{
+  if ( tasks.empty() )
+  {
+    return;
+  }
+
+  std::unique_lock< std::mutex > lock( m_mutex );
+  m_tasks = &tasks;
+  m_next_task = 0;
+  m_unfinished_tasks = tasks.size();
+  m_batch_started.notify_all();
+
+  while ( run_next_task( lock ) )
+  {
+  }
+
+  m_batch_finished.wait( lock, [ this ]() { return m_unfinished_tasks == 0; } );
+  m_tasks = nullptr;
+}
+
+}
+
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace yarrrs
+{
+
+//A fixed set of threads running one batch of tasks at a time.  The calling
+//thread takes tasks too, and run returns only after every task of the batch
+//is done, so the tasks may use anything the caller keeps alive meanwhile.
+class WorkerPool
+{
+  public:
+    using Task = std::function< void() >;
+
+    static size_t threads_from_configuration();
+
+    WorkerPool( size_t threads );
+    ~WorkerPool();
+
+    WorkerPool( const WorkerPool& ) = delete;
+    WorkerPool& operator=( const WorkerPool& ) = delete;
+
+    void run( const std::vector< Task >& tasks );
+    size_t size() const;
+
+  private:
+    void work();
+    bool run_next_task( std::unique_lock< std::mutex >& );
+
+    std::mutex m_mutex;
+    std::condition_variable m_batch_started;
+    std::condition_variable m_batch_finished;
+    const std::vector< Task >* m_tasks;
+    size_t m_next_task;
+    size_t m_unfinished_tasks;
+    bool m_is_stopping;
+    std::vector< std::thread > m_threads;
+};
+
+}
+
@@ -1,5 +1,6 @@
 #include "world.hpp"
 #include "player.hpp"
+#include "cluster.hpp"
 #include "local_event_dispatcher.hpp"
 #include <thectci/service_registry.hpp>
 
@@ -22,6 +23,8 @@
 namespace
 {
 
+const size_t spare_ships_built_per_tick( 1 );
+
 template < typename T >
 T
 string_to( const std::string& from )
@@ -77,9 +80,12 @@ create_permanent_objects( yarrr::ObjectContainer& realtime_objects )
 }
 
 yarrr::Object::Pointer
-create_player_ship( const std::string& type, const std::string& player_name_as_captain )
+create_player_ship(
+    yarrrs::ShipPool& ship_pool,
+    const std::string& type,
+    const std::string& player_name_as_captain )
 {
-  yarrr::Object::Pointer new_ship( the::ctci::service< yarrr::ObjectFactory >().create_a( type ) );
+  yarrr::Object::Pointer new_ship( ship_pool.acquire( type ) );
   if ( !new_ship )
   {
     return nullptr;
@@ -108,6 +114,10 @@ void send_help_message_to( yarrrs::Player& player )
         "commands: /mission list, /mission request <mission name>, /ship list, /ship request <object type>",
         "server" ).serialize() );
 
+  player.send( yarrr::ChatMessage(
+        "chat: /chat <global|proximity|party>, /party join <party name>, /party leave, /whisper <player name> <message>",
+        "server" ).serialize() );
+
   player.send( yarrr::ChatMessage(
         "Welcome to yarrr. If this is the first time you log in to yarrr type in the following command: /mission request tutorial",
         "server" ).serialize() );
@@ -117,61 +127,138 @@ void send_help_message_to( yarrrs::Player& player )
         "server" ).serialize() );
 }
 
+std::string
+join_from( const std::vector< std::string >& parameters, size_t first )
+{
+  std::string text;
+  for ( size_t i( first ); i < parameters.size(); ++i )
+  {
+    if ( !text.empty() )
+    {
+      text += " ";
+    }
+    text += parameters[ i ];
+  }
+  return text;
+}
+
+void
+add_chat_command_handlers_to(
+    yarrrs::CommandHandler& command_handler,
+    yarrrs::ChatRouter& chat_router )
+{
+  command_handler.register_handler( "chat",
+      [ &chat_router ]( const yarrr::Command& command, yarrrs::Player& player ) -> yarrrs::CommandHandler::Result
+      {
+        const auto& parameters( command.parameters() );
+        if ( parameters.size() < 1 || !chat_router.select_channel( player, parameters[ 0 ] ) )
+        {
+          return yarrrs::CommandHandler::Result::failure( "Invalid chat command. Channels: global, proximity, party." );
+        }
+
+        return yarrrs::CommandHandler::Result::success();
+      } );
+
+  command_handler.register_handler( "party",
+      [ &chat_router ]( const yarrr::Command& command, yarrrs::Player& player ) -> yarrrs::CommandHandler::Result
+      {
+        const auto& parameters( command.parameters() );
+        if ( parameters.size() < 1 )
+        {
+          return yarrrs::CommandHandler::Result::failure( "Invalid party command." );
+        }
+
+        const auto& sub_command( parameters[ 0 ] );
+        if ( sub_command == "leave" )
+        {
+          chat_router.leave_party( player );
+          return yarrrs::CommandHandler::Result::success();
+        }
+
+        if ( sub_command != "join" )
+        {
+          return yarrrs::CommandHandler::Result::failure( "Unknown subcommand: " + sub_command );
+        }
+
+        if ( parameters.size() < 2 )
+        {
+          return yarrrs::CommandHandler::Result::failure( "Invalid party request. Please define party name." );
+        }
+
+        chat_router.join_party( player, parameters[ 1 ] );
+        return yarrrs::CommandHandler::Result::success();
+      } );
+
+  command_handler.register_handler( "whisper",
+      [ &chat_router ]( const yarrr::Command& command, yarrrs::Player& player ) -> yarrrs::CommandHandler::Result
+      {
+        const auto& parameters( command.parameters() );
+        if ( parameters.size() < 2 )
+        {
+          return yarrrs::CommandHandler::Result::failure( "Invalid whisper. Usage: /whisper <player name> <message>" );
+        }
+
+        chat_router.whisper_to( player, parameters[ 0 ], join_from( parameters, 1 ) );
+        return yarrrs::CommandHandler::Result::success();
+      } );
+}
+
 void
 add_command_handlers_to(
     yarrrs::CommandHandler& command_handler,
     yarrr::ObjectContainer& objects,
-    const yarrrs::Player::Container& players )
+    const yarrrs::Player::Container& players,
+    yarrrs::ShipPool& ship_pool )
 {
   //todo: clean up command handlers
   command_handler.register_handler( "ship",
-      [ &objects, &players ]( const yarrr::Command& command, yarrrs::Player& player ) -> yarrrs::CommandHandler::Result
+      [ &objects, &players, &ship_pool ]( const yarrr::Command& command, yarrrs::Player& player ) -> yarrrs::CommandHandler::Result
       {
         const auto& parameters( command.parameters() );
         if ( parameters.size() < 1 )
         {
           thelog( yarrr::log::warning )( "Invalid ship command from", player.name );
-          return yarrrs::CommandHandler::Result( false, "Invalid ship command." );
+          return yarrrs::CommandHandler::Result::failure( "Invalid ship command." );
         }
 
-        const auto sub_command( command.parameters().at( 0 ) );
+        const auto& sub_command( parameters.at( 0 ) );
 
         if ( sub_command == "list" )
         {
           const auto& object_list( the::ctci::service< yarrr::ObjectFactory >().objects() );
           player.send( yarrr::ChatMessage(
                 concatenate_list( "Registered object types:", object_list ), "server" ).serialize() );
-          return yarrrs::CommandHandler::Result( true, "" );
+          return yarrrs::CommandHandler::Result::success();
         }
 
 
         if ( sub_command != "request" )
         {
           thelog( yarrr::log::warning )( "Invalid ship command from", player.name );
-          return yarrrs::CommandHandler::Result( false, "Unknown subcommand: " + sub_command );
+          return yarrrs::CommandHandler::Result::failure( "Unknown subcommand: " + sub_command );
         }
 
-        if ( command.parameters().size() < 2 )
+        if ( parameters.size() < 2 )
         {
           thelog( yarrr::log::warning )( "Invalid ship request from", player.name );
-          return yarrrs::CommandHandler::Result( false, "Invalid ship request. Please define ship type." );
+          return yarrrs::CommandHandler::Result::failure( "Invalid ship request. Please define ship type." );
         }
 
-        const std::string requested_ship_type( command.parameters().at( 1 ) );
+        const auto& requested_ship_type( parameters.at( 1 ) );
         thelog( yarrr::log::info )( "Ship type requested", requested_ship_type, "by", player.name );
-        yarrr::Object::Pointer new_ship( create_player_ship( requested_ship_type, player.name ) );
+        yarrr::Object::Pointer new_ship( create_player_ship( ship_pool, requested_ship_type, player.name ) );
 
         if ( !new_ship )
         {
           thelog( yarrr::log::info )( "Unable to create ship", requested_ship_type, "for", player.name );
-          return yarrrs::CommandHandler::Result( false, "Unknown ship type: " + requested_ship_type );
+          return yarrrs::CommandHandler::Result::failure( "Unknown ship type: " + requested_ship_type );
         }
 
-        yarrrs::broadcast( players, yarrr::DeleteObject( player.object_id() ) );
+        yarrrs::broadcast_deleted_objects( players, { player.object_id() } );
         objects.delete_object( player.object_id() );
         player.assign_object( *new_ship );
         objects.add_object( std::move( new_ship ) );
-        return yarrrs::CommandHandler::Result( true, "" );
+        return yarrrs::CommandHandler::Result::success();
       } );
 
   command_handler.register_handler( "mission",
@@ -180,38 +267,38 @@ add_command_handlers_to(
         const auto& parameters( command.parameters() );
         if ( parameters.size() < 1 )
         {
-          return yarrrs::CommandHandler::Result( false, "Invalid mission command." );
+          return yarrrs::CommandHandler::Result::failure( "Invalid mission command." );
         }
 
-        const auto sub_command( command.parameters()[ 0 ] );
+        const auto& sub_command( parameters[ 0 ] );
         yarrr::MissionFactory& mission_factory{ the::ctci::service< yarrr::MissionFactory >() };
 
         if ( sub_command == "list" )
         {
           player.send( yarrr::ChatMessage(
                 concatenate_list( "Registered missions: ", mission_factory.missions() ), "server" ).serialize() );
-          return yarrrs::CommandHandler::Result( true, "" );
+          return yarrrs::CommandHandler::Result::success();
         }
 
         if ( "request" != sub_command )
         {
-          return yarrrs::CommandHandler::Result( false, "Unknown subcommand." );
+          return yarrrs::CommandHandler::Result::failure( "Unknown subcommand." );
         }
 
         if ( parameters.size() < 2 )
         {
-          return yarrrs::CommandHandler::Result( false, "Invalid mission request." );
+          return yarrrs::CommandHandler::Result::failure( "Invalid mission request." );
         }
 
-        const auto requested_mission( command.parameters()[ 1 ] );
+        const auto& requested_mission( parameters[ 1 ] );
         auto new_mission( mission_factory.create_a( requested_mission ) );
         if ( !new_mission )
         {
-          return yarrrs::CommandHandler::Result( false, "Unknown mission type: " + requested_mission );
+          return yarrrs::CommandHandler::Result::failure( "Unknown mission type: " + requested_mission );
         }
 
         player.start_mission( std::move( new_mission ) );
-        return yarrrs::CommandHandler::Result( true, "" );
+        return yarrrs::CommandHandler::Result::success();
       } );
 }
 
@@ -250,9 +337,16 @@ namespace yarrrs
 {
 
 //todo: tear this up to separate handlers
-World::World( Player::Container& players, yarrr::ObjectContainer& objects )
+World::World( Player::Container& players, yarrr::ObjectContainer& objects, Cluster* cluster )
   : m_players( players )
   , m_objects( objects )
+  , m_cluster( cluster )
+  , m_chat_router( players, objects )
+  , m_ship_pool(
+      the::ctci::service< yarrr::ObjectFactory >(),
+      ShipPool::spares_per_type_from_configuration() )
+  , m_logged_in_players( the::ctci::service< Metrics >().gauge(
+        "yarrr_logged_in_players", "Players logged in to the world." ) )
 {
   the::ctci::Dispatcher& local_event_dispatcher(
       the::ctci::service< LocalEventDispatcher >().dispatcher );
@@ -263,6 +357,9 @@ World::World( Player::Container& players, yarrr::ObjectContainer& objects )
   local_event_dispatcher.register_listener< PlayerLoggedOut >(
       [ this ]( const PlayerLoggedOut& logged_out ){ handle_player_logged_out( logged_out ); } );
 
+  local_event_dispatcher.register_listener< ChatPosted >(
+      [ this ]( const ChatPosted& posted ){ handle_chat_posted( posted ); } );
+
   the::ctci::Dispatcher& engine_dispatcher(
       the::ctci::service< yarrr::EngineDispatcher >() );
 
@@ -275,12 +372,27 @@ World::World( Player::Container& players, yarrr::ObjectContainer& objects )
   engine_dispatcher.register_listener< yarrr::PlayerKilled >(
       [ this ]( const yarrr::PlayerKilled& killed ){ handle_player_killed( killed ); } );
 
-  add_command_handlers_to( m_command_handler, m_objects, m_players );
+  m_ship_pool.keep_spares_of( "ship" );
+  add_command_handlers_to( m_command_handler, m_objects, m_players, m_ship_pool );
+  add_chat_command_handlers_to( m_command_handler, m_chat_router );
   create_permanent_objects( objects );
 }
 
 void
-World::handle_player_killed( const yarrr::PlayerKilled& player_killed ) const
+World::tick()
+{
+  m_chat_router.flush();
+  m_ship_pool.refill( spare_ships_built_per_tick );
+}
+
+void
+World::handle_chat_posted( const ChatPosted& posted )
+{
+  m_chat_router.post( posted.sender, posted.message );
+}
+
+void
+World::handle_player_killed( const yarrr::PlayerKilled& player_killed )
 {
   Player* player( player_with_object_id( m_players, player_killed.object_id ) );
   if ( !player )
@@ -291,7 +403,7 @@ World::handle_player_killed( const yarrr::PlayerKilled& player_killed ) const
 
   thelog( yarrr::log::debug )( "Player killed.", player->name );
 
-  yarrr::Object::Pointer new_object( create_player_ship( "ship", player->name ) );
+  yarrr::Object::Pointer new_object( create_player_ship( m_ship_pool, "ship", player->name ) );
   if ( !new_object )
   {
     thelog( yarrr::log::error )( "Unable to create ship." );
@@ -305,50 +417,66 @@ World::handle_player_killed( const yarrr::PlayerKilled& player_killed ) const
 }
 
 void
-World::handle_delete_object( const yarrr::DeleteObject& del_object ) const
+World::handle_delete_object( const yarrr::DeleteObject& del_object )
 {
   thelog( yarrr::log::debug )( __PRETTY_FUNCTION__, del_object.object_id() );
   delete_object( del_object.object_id() );
 }
 
 void
-World::add_object( yarrr::Object::Pointer&& object_ptr ) const
+World::add_object( yarrr::Object::Pointer&& object )
 {
-  //todo: fix this abomination
-  yarrr::Object* object( object_ptr.release() );
-  the::ctci::service< yarrr::MainThreadCallbackQueue >().push_back(
-      [ this, object ]()
-      {
-        m_objects.add_object( yarrr::Object::Pointer( object ) );
-      } );
+  schedule_object_commands();
+  m_object_commands.add( std::move( object ) );
 }
 
 void
-World::delete_object( yarrr::Object::Id id ) const
+World::delete_object( yarrr::Object::Id id )
 {
   thelog( yarrr::log::debug )( "Deleting object", id );
+  schedule_object_commands();
+  m_object_commands.remove( id );
+}
+
+void
+World::schedule_object_commands()
+{
+  if ( !m_object_commands.empty() )
+  {
+    return;
+  }
+
   the::ctci::service< yarrr::MainThreadCallbackQueue >().push_back(
-      [ this, id ]()
+      [ this ]()
       {
-        yarrrs::broadcast( m_players, yarrr::DeleteObject( id ) );
-        m_objects.delete_object( id );
+        apply_object_commands();
       } );
 }
 
 void
-World::handle_object_created( const yarrr::ObjectCreated& object_created ) const
+World::apply_object_commands()
 {
-  //todo: fix this abomination
-  yarrr::Object* object( object_created.object.release() );
-  the::ctci::service< yarrr::MainThreadCallbackQueue >().push_back(
-      [ this, object ]()
+  m_object_commands.apply_to( m_objects,
+      [ this ]( const ObjectCommandBuffer::DeletedIds& ids )
       {
-        m_objects.add_object( yarrr::Object::Pointer( object ) );
+        yarrrs::broadcast_deleted_objects( m_players, ids );
       } );
 }
 
 void
-World::handle_player_logged_in( const PlayerLoggedIn& login ) const
+World::handle_object_created( const yarrr::ObjectCreated& object_created )
+{
+  add_object( std::move( object_created.object ) );
+}
+
+void
+World::update_player_metrics()
+{
+  m_logged_in_players.set( m_players.size() );
+}
+
+void
+World::handle_player_logged_in( const PlayerLoggedIn& login )
 {
   thelog_trace( yarrr::log::info, __PRETTY_FUNCTION__ );
 
@@ -358,26 +486,47 @@ World::handle_player_logged_in( const PlayerLoggedIn& login ) const
     return;
   }
 
-  yarrr::Object::Pointer new_object( create_player_ship( "ship", login.name ) );
+  if ( m_cluster && !m_cluster->claim_player( login.name ) )
+  {
+    thelog( yarrr::log::warning )( "User is already logged in on another node:", login.name );
+    login.connection_wrapper.connection->send(
+        yarrr::ChatMessage( m_cluster->refusal_of( login.name ), "server" ).serialize() );
+    return;
+  }
+
+  yarrr::Object::Pointer new_object( create_player_ship( m_ship_pool, "ship", login.name ) );
   if ( !new_object )
   {
     thelog( yarrr::log::error )( "Unable to create ship for new user:", login.name );
+    if ( m_cluster )
+    {
+      m_cluster->release_player( login.name );
+    }
     return;
   }
 
+  if ( m_cluster )
+  {
+    m_cluster->take_handed_off_ship(
+        login.name,
+        yarrr::component_of< yarrr::PhysicalBehavior >( *new_object ).physical_parameters );
+  }
+
   m_players.emplace( std::make_pair(
         login.id,
         Player::Pointer( new Player(
             m_players,
             login.name,
             login.connection_wrapper,
-            m_command_handler ) ) ) );
+            m_command_handler,
+            login.capabilities ) ) ) );
 
   Player& new_player( *m_players[ login.id ] );
   send_help_message_to( new_player );
   new_player.assign_object( *new_object );
   m_objects.add_object( std::move( new_object ) );
 
+  update_player_metrics();
   const std::string notification( std::string( "Player logged in: " ) + login.name );
   thelog( yarrr::log::info )( notification );
   yarrrs::broadcast( m_players, yarrr::ChatMessage( notification, "server" ) );
@@ -385,7 +534,7 @@ World::handle_player_logged_in( const PlayerLoggedIn& login ) const
 
 
 void
-World::handle_player_logged_out( const PlayerLoggedOut& logout ) const
+World::handle_player_logged_out( const PlayerLoggedOut& logout )
 {
   thelog_trace( yarrr::log::info, __PRETTY_FUNCTION__ );
   const auto player( m_players.find( logout.id ) );
@@ -398,6 +547,12 @@ World::handle_player_logged_out( const PlayerLoggedOut& logout ) const
   const auto player_name( player->second->name );
   const auto object_id( player->second->object_id() );
   m_players.erase( logout.id );
+  m_chat_router.forget( player_name );
+  if ( m_cluster )
+  {
+    m_cluster->release_player( player_name );
+  }
+  update_player_metrics();
 
   thelog( yarrr::log::warning )( "Deleting player and object.", object_id, player_name );
   yarrrs::broadcast( m_players, yarrr::ChatMessage( "Player logged out: " + player_name, "server" ) );
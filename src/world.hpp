@@ -2,6 +2,9 @@
 
 #include "player.hpp"
 #include "command_handler.hpp"
+#include "chat_router.hpp"
+#include "ship_pool.hpp"
+#include "object_command_buffer.hpp"
 
 namespace yarrr
 {
@@ -14,24 +17,37 @@ namespace yarrr
 namespace yarrrs
 {
 
+class Cluster;
+
 class World
 {
   public:
-    World( Player::Container&, yarrr::ObjectContainer& );
+    World( Player::Container&, yarrr::ObjectContainer&, Cluster* cluster = nullptr );
 
-  private:
-    void handle_player_logged_in( const PlayerLoggedIn& ) const;
-    void handle_player_logged_out( const PlayerLoggedOut& ) const;
-    void handle_object_created( const yarrr::ObjectCreated& add_object ) const;
-    void handle_delete_object( const yarrr::DeleteObject& delete_object ) const;
-    void handle_player_killed( const yarrr::PlayerKilled& player_killed ) const;
+    void tick();
 
-    void delete_object( yarrr::Object::Id id ) const;
-    void add_object( yarrr::Object::Pointer&& object ) const;
+  private:
+    void handle_player_logged_in( const PlayerLoggedIn& );
+    void handle_player_logged_out( const PlayerLoggedOut& );
+    void handle_chat_posted( const ChatPosted& );
+    void handle_object_created( const yarrr::ObjectCreated& add_object );
+    void handle_delete_object( const yarrr::DeleteObject& delete_object );
+    void handle_player_killed( const yarrr::PlayerKilled& player_killed );
+
+    void delete_object( yarrr::Object::Id id );
+    void add_object( yarrr::Object::Pointer&& object );
+    void schedule_object_commands();
+    void apply_object_commands();
+    void update_player_metrics();
 
     Player::Container& m_players;
     yarrr::ObjectContainer& m_objects;
+    Cluster* const m_cluster;
     yarrrs::CommandHandler m_command_handler;
+    ChatRouter m_chat_router;
+    ShipPool m_ship_pool;
+    ObjectCommandBuffer m_object_commands;
+    Metrics::Value& m_logged_in_players;
 };
 
 }
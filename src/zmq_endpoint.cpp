@@ -0,0 +1,108 @@
+#include "zmq_endpoint.hpp"
+
+#include <yarrr/log.hpp>
+#include <zmq.h>
+
+namespace
+{
+
+const long poll_timeout_milliseconds( 100 );
+
+}
+
+namespace yarrrs
+{
+
+ZmqEndpoint::ZmqEndpoint( int socket_type )
+  : m_context( zmq_ctx_new() )
+  , m_socket( zmq_socket( m_context, socket_type ) )
+  , m_is_running( false )
+{
+  const int linger( 0 );
+  zmq_setsockopt( m_socket, ZMQ_LINGER, &linger, sizeof( linger ) );
+}
+
+ZmqEndpoint::~ZmqEndpoint()
+{
+  stop();
+  zmq_close( m_socket );
+  zmq_ctx_term( m_context );
+}
+
+void*
+ZmqEndpoint::socket()
+{
+  return m_socket;
+}
+
+bool
+ZmqEndpoint::bind( const std::string& endpoint )
+{
+  m_endpoint = endpoint;
+  if ( zmq_bind( m_socket, endpoint.c_str() ) != 0 )
+  {
+    thelog( yarrr::log::error )( "Unable to bind zmq endpoint:", endpoint, zmq_strerror( zmq_errno() ) );
+    return false;
+  }
+
+  return true;
+}
+
+void
+ZmqEndpoint::start( Callback when_readable, Callback after_poll )
+{
+  m_is_running = true;
+  m_thread = std::thread( &ZmqEndpoint::serve, this, std::move( when_readable ), std::move( after_poll ) );
+}
+
+void
+ZmqEndpoint::stop()
+{
+  m_is_running = false;
+  if ( m_thread.joinable() )
+  {
+    m_thread.join();
+  }
+}
+
+bool
+ZmqEndpoint::is_running() const
+{
+  return m_is_running;
+}
+
+bool
+ZmqEndpoint::send( const void* data, size_t size, int flags )
+{
+  if ( zmq_send( m_socket, data, size, flags ) < 0 )
+  {
+    log_send_failure();
+    return false;
+  }
+
+  return true;
+}
+
+void
+ZmqEndpoint::log_send_failure() const
+{
+  thelog( yarrr::log::warning )( "Unable to send on zmq endpoint:", m_endpoint, zmq_strerror( zmq_errno() ) );
+}
+
+void
+ZmqEndpoint::serve( Callback when_readable, Callback after_poll )
+{
+  while ( m_is_running )
+  {
+    zmq_pollitem_t item{ m_socket, 0, ZMQ_POLLIN, 0 };
+    if ( zmq_poll( &item, 1, poll_timeout_milliseconds ) > 0 && ( item.revents & ZMQ_POLLIN ) )
+    {
+      when_readable();
+    }
+
+    after_poll();
+  }
+}
+
+}
+
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace yarrrs
+{
+
+//A zmq socket bound to an endpoint and served on a thread of its own.  The
+//thread calls back whenever the socket is readable, and after every poll, so
+//a publisher sends on its own schedule.  The callbacks run on that thread only.
+class ZmqEndpoint
+{
+  public:
+    using Callback = std::function< void() >;
+
+    ZmqEndpoint( int socket_type );
+    ~ZmqEndpoint();
+
+    ZmqEndpoint( const ZmqEndpoint& ) = delete;
+    ZmqEndpoint& operator=( const ZmqEndpoint& ) = delete;
+
+    //set the options of the socket before it is bound
+    void* socket();
+    bool bind( const std::string& endpoint );
+    void start( Callback when_readable, Callback after_poll = [](){} );
+    //joins the thread, the callbacks are not called afterwards
+    void stop();
+    bool is_running() const;
+
+    //logs the failures
+    bool send( const void* data, size_t size, int flags );
+    void log_send_failure() const;
+
+  private:
+    void serve( Callback when_readable, Callback after_poll );
+
+    std::string m_endpoint;
+    void* m_context;
+    void* m_socket;
+    std::atomic< bool > m_is_running;
+    std::thread m_thread;
+};
+
+}
+
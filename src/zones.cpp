@@ -0,0 +1,168 @@
+#include "zones.hpp"
+#include "configuration.hpp"
+#include "object_position.hpp"
+#include "worker_pool.hpp"
+
+#include <yarrr/object_container.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+namespace
+{
+
+int64_t
+zone_index_of( int64_t coordinate, int64_t zone_size )
+{
+  return coordinate >= 0 ?
+    coordinate / zone_size :
+    ( coordinate - zone_size + 1 ) / zone_size;
+}
+
+void
+serialize_into(
+    std::vector< yarrr::Data >& serialized,
+    const yarrrs::Zones::Updates& updates,
+    const std::vector< bool >& is_needed,
+    const std::vector< size_t >& indices )
+{
+  for ( const auto index : indices )
+  {
+    if ( is_needed[ index ] )
+    {
+      serialized[ index ] = updates[ index ]->serialize();
+    }
+  }
+}
+
+}
+
+namespace yarrrs
+{
+
+int64_t
+Zones::size_from_configuration()
+{
+  return std::max< int64_t >( 0, configured_or< int64_t >( "zone_size", 0 ) );
+}
+
+size_t
+Zones::KeyHash::operator()( const Key& key ) const
+{
+  return std::hash< int64_t >()( key.first ) * 31 + std::hash< int64_t >()( key.second );
+}
+
+Zones::Zones( int64_t zone_size, WorkerPool& workers )
+  : m_zone_size( zone_size )
+  , m_workers( workers )
+  , m_zones( the::ctci::service< Metrics >().gauge(
+        "yarrr_zones", "Zones with at least one object in them." ) )
+  , m_border_crossings( the::ctci::service< Metrics >().counter(
+        "yarrr_zone_border_crossings_total", "Objects that moved into another zone." ) )
+{
+}
+
+Zones::Key
+Zones::zone_of( const yarrr::Coordinate& coordinate ) const
+{
+  return Key( zone_index_of( coordinate.x, m_zone_size ), zone_index_of( coordinate.y, m_zone_size ) );
+}
+
+bool
+Zones::zone_of_object( yarrr::Object::Id id, Key& zone ) const
+{
+  const auto assigned( m_zone_of_object.find( id ) );
+  if ( assigned == std::end( m_zone_of_object ) )
+  {
+    return false;
+  }
+
+  zone = assigned->second;
+  return true;
+}
+
+bool
+Zones::are_neighbors( const Key& a, const Key& b )
+{
+  return std::llabs( a.first - b.first ) <= 1 && std::llabs( a.second - b.second ) <= 1;
+}
+
+void
+Zones::assign( const yarrr::ObjectContainer& objects, const Updates& updates )
+{
+  std::unordered_map< yarrr::Object::Id, Key > zone_of_object;
+  zone_of_object.reserve( updates.size() );
+  for ( auto& zone : m_updates_of_zone )
+  {
+    zone.second.clear();
+  }
+  m_updates_without_zone.clear();
+
+  for ( size_t index( 0 ); index < updates.size(); ++index )
+  {
+    const yarrr::Object::Id id( updates[ index ]->id() );
+    yarrr::Coordinate position;
+    if ( !position_of_object( objects, id, position ) )
+    {
+      m_updates_without_zone.push_back( index );
+      continue;
+    }
+
+    const Key zone( zone_of( position ) );
+    zone_of_object.emplace( id, zone );
+    m_updates_of_zone[ zone ].push_back( index );
+
+    const auto previous( m_zone_of_object.find( id ) );
+    if ( previous != std::end( m_zone_of_object ) && previous->second != zone )
+    {
+      m_border_crossings.increment();
+    }
+  }
+
+  for ( auto zone( std::begin( m_updates_of_zone ) ); zone != std::end( m_updates_of_zone ); )
+  {
+    zone = zone->second.empty() ? m_updates_of_zone.erase( zone ) : std::next( zone );
+  }
+
+  m_zone_of_object.swap( zone_of_object );
+  m_zones.set( m_updates_of_zone.size() );
+}
+
+std::vector< yarrr::Data >
+Zones::serialize( const Updates& updates, const std::vector< bool >& is_needed ) const
+{
+  std::vector< yarrr::Data > serialized( updates.size() );
+  std::vector< WorkerPool::Task > tasks;
+  tasks.reserve( m_updates_of_zone.size() + 1 );
+  for ( const auto& zone : m_updates_of_zone )
+  {
+    const std::vector< size_t >& indices( zone.second );
+    tasks.push_back(
+        [ &serialized, &updates, &is_needed, &indices ]()
+        {
+          serialize_into( serialized, updates, is_needed, indices );
+        } );
+  }
+
+  if ( !m_updates_without_zone.empty() )
+  {
+    tasks.push_back(
+        [ this, &serialized, &updates, &is_needed ]()
+        {
+          serialize_into( serialized, updates, is_needed, m_updates_without_zone );
+        } );
+  }
+
+  m_workers.run( tasks );
+  return serialized;
+}
+
+size_t
+Zones::number_of_zones() const
+{
+  return m_updates_of_zone.size();
+}
+
+}
+
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "metrics.hpp"
+#include <yarrr/object.hpp>
+#include <yarrr/basic_behaviors.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace yarrr
+{
+
+class ObjectContainer;
+
+}
+
+namespace yarrrs
+{
+
+class WorkerPool;
+
+//Splits the universe into square zones.  Every tick each object with a position
+//is assigned to the zone it is in, and objects crossing a border are counted.
+//A player sees the zone of its ship and the eight around it.  The zones only
+//group the updates: the objects stay in the one container and are simulated on
+//the main thread, only the serialization of the updates of different zones
+//runs on the worker threads.
+class Zones
+{
+  public:
+    using Key = std::pair< int64_t, int64_t >;
+    using Updates = std::vector< yarrr::ObjectUpdate::Pointer >;
+
+    //zero when the universe is not split into zones
+    static int64_t size_from_configuration();
+
+    Zones( int64_t zone_size, WorkerPool& );
+
+    Key zone_of( const yarrr::Coordinate& ) const;
+    bool zone_of_object( yarrr::Object::Id, Key& ) const;
+    static bool are_neighbors( const Key&, const Key& );
+
+    void assign( const yarrr::ObjectContainer&, const Updates& );
+    //serializes the needed updates of each zone on a worker thread, the
+    //others are left empty
+    std::vector< yarrr::Data > serialize( const Updates&, const std::vector< bool >& is_needed ) const;
+
+    size_t number_of_zones() const;
+
+  private:
+    class KeyHash
+    {
+      public:
+        size_t operator()( const Key& ) const;
+    };
+
+    const int64_t m_zone_size;
+    WorkerPool& m_workers;
+    std::unordered_map< yarrr::Object::Id, Key > m_zone_of_object;
+    std::unordered_map< Key, std::vector< size_t >, KeyHash > m_updates_of_zone;
+    std::vector< size_t > m_updates_without_zone;
+    Metrics::Value& m_zones;
+    Metrics::Value& m_border_crossings;
+};
+
+}
+
@@ -0,0 +1,172 @@
+#include "../src/chat_router.hpp"
+#include "test_services.hpp"
+
+#include <yarrr/chat_message.hpp>
+#include <yarrr/object.hpp>
+#include <yarrr/object_container.hpp>
+#include <yarrr/basic_behaviors.hpp>
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( a_chat_router )
+{
+  test::Services::PlayerBundle::Pointer log_in( const std::string& name )
+  {
+    auto bundle( services->create_player( name ) );
+    services->players[ bundle->connection.connection->id ] = bundle->take_player_ownership();
+    return bundle;
+  }
+
+  void place_ship_of( yarrrs::Player& player, yarrr::Coordinate::type x, yarrr::Coordinate::type y )
+  {
+    yarrr::Object::Pointer ship( new yarrr::Object() );
+    ship->add_behavior( std::make_unique< yarrr::PhysicalBehavior >() );
+    auto& coordinate( yarrr::component_of< yarrr::PhysicalBehavior >( *ship ).physical_parameters.coordinate );
+    coordinate.x = x;
+    coordinate.y = y;
+    player.assign_object( *ship );
+    services->objects.add_object( std::move( ship ) );
+  }
+
+  void flush_connections()
+  {
+    sender->connection.flush_connection();
+    friend_of_sender->connection.flush_connection();
+    stranger->connection.flush_connection();
+  }
+
+  void SetUp()
+  {
+    services = std::make_unique< test::Services >();
+    chat_router = std::make_unique< yarrrs::ChatRouter >( services->players, services->objects );
+    sender = log_in( "Kilgore Trout" );
+    friend_of_sender = log_in( "Rabo Karabekian" );
+    stranger = log_in( "Eliot Rosewater" );
+    flush_connections();
+  }
+
+  void TearDown()
+  {
+    chat_router.reset();
+    sender.reset();
+    friend_of_sender.reset();
+    stranger.reset();
+    services.reset();
+  }
+
+  It ( sends_nothing_before_flush )
+  {
+    chat_router->post( sender->player, message );
+    AssertThat( friend_of_sender->connection.has_no_data(), Equals( true ) );
+  }
+
+  It ( sends_global_messages_to_every_player )
+  {
+    chat_router->post( sender->player, message );
+    chat_router->flush();
+    AssertThat( friend_of_sender->connection.get_entity< yarrr::ChatMessage >()->message(), Equals( message.message() ) );
+    AssertThat( stranger->connection.get_entity< yarrr::ChatMessage >()->message(), Equals( message.message() ) );
+  }
+
+  It ( sends_party_messages_to_party_members_only )
+  {
+    chat_router->join_party( sender->player, "crew" );
+    chat_router->join_party( friend_of_sender->player, "crew" );
+    chat_router->post( sender->player, message );
+    chat_router->flush();
+    AssertThat( friend_of_sender->connection.get_entity< yarrr::ChatMessage >()->message(), Equals( message.message() ) );
+    AssertThat( stranger->connection.has_no_data(), Equals( true ) );
+  }
+
+  It ( stops_sending_party_messages_to_players_who_left_the_party )
+  {
+    chat_router->join_party( sender->player, "crew" );
+    chat_router->join_party( friend_of_sender->player, "crew" );
+    chat_router->leave_party( friend_of_sender->player );
+    chat_router->post( sender->player, message );
+    chat_router->flush();
+    AssertThat( friend_of_sender->connection.has_no_data(), Equals( true ) );
+  }
+
+  It ( tells_the_sender_if_the_party_channel_is_selected_without_a_party )
+  {
+    AssertThat( chat_router->select_channel( sender->player, "party" ), Equals( true ) );
+    chat_router->post( sender->player, message );
+    chat_router->flush();
+    AssertThat( sender->connection.get_entity< yarrr::ChatMessage >()->message(), Contains( "not in a party" ) );
+    AssertThat( friend_of_sender->connection.has_no_data(), Equals( true ) );
+  }
+
+  It ( refuses_unknown_channels )
+  {
+    AssertThat( chat_router->select_channel( sender->player, "pirate radio" ), Equals( false ) );
+  }
+
+  It ( sends_proximity_messages_to_nearby_players_only )
+  {
+    place_ship_of( sender->player, 0, 0 );
+    place_ship_of( friend_of_sender->player, 100, 100 );
+    place_ship_of( stranger->player, 100000000, 0 );
+    chat_router->select_channel( sender->player, "proximity" );
+    chat_router->post( sender->player, message );
+    chat_router->flush();
+    AssertThat( sender->connection.has_entity< yarrr::ChatMessage >(), Equals( true ) );
+    AssertThat( friend_of_sender->connection.has_entity< yarrr::ChatMessage >(), Equals( true ) );
+    AssertThat( stranger->connection.has_no_data(), Equals( true ) );
+  }
+
+  It ( sends_whispers_to_the_recipient_and_echoes_them_to_the_sender )
+  {
+    chat_router->whisper_to( sender->player, friend_of_sender->player.name, "psst" );
+    chat_router->flush();
+    AssertThat( friend_of_sender->connection.get_entity< yarrr::ChatMessage >()->message(), Equals( "psst" ) );
+    AssertThat( sender->connection.get_entity< yarrr::ChatMessage >()->message(), Equals( "psst" ) );
+    AssertThat( stranger->connection.has_no_data(), Equals( true ) );
+  }
+
+  It ( tells_the_sender_if_the_whisper_recipient_is_unknown )
+  {
+    chat_router->whisper_to( sender->player, "Billy Pilgrim", "psst" );
+    chat_router->flush();
+    AssertThat( sender->connection.get_entity< yarrr::ChatMessage >()->message(), Contains( "Billy Pilgrim" ) );
+  }
+
+  It ( drops_messages_over_the_rate_limit_and_tells_the_sender )
+  {
+    for ( int i( 0 ); i < default_burst; ++i )
+    {
+      chat_router->post( sender->player, message );
+    }
+    sender->connection.flush_connection();
+
+    chat_router->post( sender->player, message );
+    AssertThat( sender->connection.get_entity< yarrr::ChatMessage >()->message(), Contains( "too fast" ) );
+    chat_router->flush();
+    AssertThat( friend_of_sender->connection.entities< yarrr::ChatMessage >(), HasLength( default_burst ) );
+  }
+
+  It ( tells_a_flooding_sender_only_once_until_a_message_gets_through )
+  {
+    for ( int i( 0 ); i < default_burst; ++i )
+    {
+      chat_router->post( sender->player, message );
+    }
+    sender->connection.flush_connection();
+
+    for ( int i( 0 ); i < 10; ++i )
+    {
+      chat_router->post( sender->player, message );
+    }
+    AssertThat( sender->connection.entities< yarrr::ChatMessage >(), HasLength( 1u ) );
+  }
+
+  const int default_burst{ 5 };
+  const yarrr::ChatMessage message{ "ahoy", "Kilgore Trout" };
+  std::unique_ptr< test::Services > services;
+  std::unique_ptr< yarrrs::ChatRouter > chat_router;
+  test::Services::PlayerBundle::Pointer sender;
+  test::Services::PlayerBundle::Pointer friend_of_sender;
+  test::Services::PlayerBundle::Pointer stranger;
+};
+
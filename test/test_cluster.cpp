@@ -0,0 +1,297 @@
+#include "../src/cluster.hpp"
+#include "../src/worker_pool.hpp"
+#include "../src/zones.hpp"
+#include "test_services.hpp"
+
+#include <yarrr/object.hpp>
+#include <yarrr/object_factory.hpp>
+#include <yarrr/object_container.hpp>
+#include <yarrr/basic_behaviors.hpp>
+#include <yarrr/chat_message.hpp>
+#include <thectci/service_registry.hpp>
+#include <igloo/igloo_alt.h>
+
+#include <map>
+
+using namespace igloo;
+
+namespace
+{
+
+class InMemoryStore : public yarrrs::Cluster::Store
+{
+  public:
+    virtual bool acquire( const std::string& key, const std::string& owner, int64_t ) override
+    {
+      ++acquires;
+      if ( !is_answering )
+      {
+        return false;
+      }
+
+      const auto value( values.find( key ) );
+      if ( value != std::end( values ) && value->second != owner )
+      {
+        return false;
+      }
+
+      values[ key ] = owner;
+      return true;
+    }
+
+    virtual std::vector< bool > acquire_all(
+        const std::vector< std::string >& keys, const std::string& owner, int64_t lease_milliseconds ) override
+    {
+      ++round_trips;
+      return Store::acquire_all( keys, owner, lease_milliseconds );
+    }
+
+    virtual void release( const std::string& key, const std::string& owner ) override
+    {
+      const auto value( values.find( key ) );
+      if ( value != std::end( values ) && value->second == owner )
+      {
+        values.erase( value );
+      }
+    }
+
+    virtual bool get( const std::string& key, std::string& value ) override
+    {
+      if ( !is_answering )
+      {
+        return false;
+      }
+
+      const auto stored( values.find( key ) );
+      if ( stored == std::end( values ) )
+      {
+        return false;
+      }
+
+      value = stored->second;
+      return true;
+    }
+
+    virtual void put( const std::string& key, const std::string& value, int64_t ) override
+    {
+      values[ key ] = value;
+    }
+
+    virtual bool take( const std::string& key, std::string& value ) override
+    {
+      const bool has_value( get( key, value ) );
+      values.erase( key );
+      return has_value;
+    }
+
+    std::map< std::string, std::string > values;
+    bool is_answering{ true };
+    int acquires{ 0 };
+    int round_trips{ 0 };
+};
+
+}
+
+Describe( a_cluster )
+{
+  void SetUp()
+  {
+    services = std::make_unique< test::Services >();
+    store = std::make_unique< InMemoryStore >();
+    cluster = std::make_unique< yarrrs::Cluster >(
+        *store,
+        yarrrs::Cluster::Configuration{ "here", "127.0.0.1:2001", 3000, 1 } );
+    workers = std::make_unique< yarrrs::WorkerPool >( 1 );
+    zones = std::make_unique< yarrrs::Zones >( zone_size, *workers );
+    store->values[ "cluster:node:there" ] = "127.0.0.1:2002";
+
+    the::ctci::service< yarrr::ObjectFactory >().register_creator(
+        "ship",
+        []()
+        {
+          yarrr::Object::Pointer ship( new yarrr::Object() );
+          ship->add_behavior( std::make_unique< yarrr::PhysicalBehavior >() );
+          return ship;
+        } );
+  }
+
+  void TearDown()
+  {
+    zones.reset();
+    workers.reset();
+    cluster.reset();
+    services.reset();
+  }
+
+  test::Services::PlayerBundle& add_player_at( const std::string& name, yarrr::Coordinate::type x )
+  {
+    bundles.push_back( services->create_player( name ) );
+    auto& bundle( *bundles.back() );
+    services->players[ bundle.connection.connection->id ] = bundle.take_player_ownership();
+
+    yarrr::Object::Pointer ship( new yarrr::Object() );
+    ship->add_behavior( std::make_unique< yarrr::PhysicalBehavior >() );
+    yarrr::component_of< yarrr::PhysicalBehavior >( *ship ).physical_parameters.coordinate = yarrr::Coordinate( x, 0 );
+    bundle.player.assign_object( *ship );
+    services->objects.add_object( std::move( ship ) );
+    cluster->claim_player( name );
+    bundle.connection.flush_connection();
+    return bundle;
+  }
+
+  std::vector< int > tick()
+  {
+    return cluster->tick( services->players, services->objects, zones.get() );
+  }
+
+  void log_in( const std::string& name )
+  {
+    connections.push_back( std::make_unique< test::Connection >() );
+    services->local_event_dispatcher.dispatcher.dispatch(
+        yarrrs::PlayerLoggedIn(
+          connections.back()->wrapper,
+          connections.back()->connection->id,
+          name ) );
+    services->main_thread_callback_queue.process_callbacks();
+  }
+
+  It( claims_players_logged_in_nowhere_else )
+  {
+    AssertThat( cluster->claim_player( "Kilgore Trout" ), Equals( true ) );
+    AssertThat( store->values[ "cluster:player:Kilgore Trout" ], Equals( "here" ) );
+  }
+
+  It( refuses_players_logged_in_on_another_node )
+  {
+    store->values[ "cluster:player:Kilgore Trout" ] = "there";
+    AssertThat( cluster->claim_player( "Kilgore Trout" ), Equals( false ) );
+  }
+
+  It( releases_only_its_own_leases )
+  {
+    store->values[ "cluster:player:Kilgore Trout" ] = "there";
+    cluster->release_player( "Kilgore Trout" );
+    AssertThat( store->values[ "cluster:player:Kilgore Trout" ], Equals( "there" ) );
+  }
+
+  It( publishes_its_address )
+  {
+    tick();
+    AssertThat( store->values[ "cluster:node:here" ], Equals( "127.0.0.1:2001" ) );
+  }
+
+  It( leases_the_zones_of_its_players )
+  {
+    add_player_at( "Kilgore Trout", 10 );
+    AssertThat( tick(), IsEmpty() );
+    AssertThat( store->values[ "cluster:zone:0:0" ], Equals( "here" ) );
+  }
+
+  It( renews_the_leases_of_a_tick_in_a_round_trip_for_players_and_one_for_zones )
+  {
+    add_player_at( "Kilgore Trout", 10 );
+    add_player_at( "Rabo Karabekian", 20 );
+    add_player_at( "Eliot Rosewater", zone_size + 10 );
+    store->acquires = 0;
+
+    tick();
+    AssertThat( store->round_trips, Equals( 2 ) );
+    AssertThat( store->acquires, Equals( 5 ) );
+  }
+
+  It( releases_the_zones_its_players_left )
+  {
+    auto& bundle( add_player_at( "Kilgore Trout", 10 ) );
+    tick();
+    services->objects.delete_object( bundle.player.object_id() );
+    tick();
+    AssertThat( store->values.count( "cluster:zone:0:0" ), Equals( 0u ) );
+  }
+
+  It( hands_off_players_entering_a_zone_of_another_node )
+  {
+    store->values[ "cluster:zone:1:0" ] = "there";
+    auto& bundle( add_player_at( "Kilgore Trout", zone_size + 10 ) );
+    const int connection_id( bundle.connection.connection->id );
+
+    AssertThat( tick(), Equals( std::vector< int >{ connection_id } ) );
+    AssertThat( store->values.count( "cluster:player:Kilgore Trout" ), Equals( 0u ) );
+    AssertThat( store->values.count( "cluster:handoff:Kilgore Trout" ), Equals( 1u ) );
+    AssertThat( bundle.connection.get_entity< yarrr::ChatMessage >()->message(), Contains( "127.0.0.1:2002" ) );
+  }
+
+  It( drops_players_whose_lease_another_node_took )
+  {
+    auto& bundle( add_player_at( "Kilgore Trout", 10 ) );
+    const int connection_id( bundle.connection.connection->id );
+    store->values[ "cluster:player:Kilgore Trout" ] = "there";
+
+    AssertThat( tick(), Equals( std::vector< int >{ connection_id } ) );
+    AssertThat( bundle.connection.get_entity< yarrr::ChatMessage >()->message(), Contains( "another server" ) );
+    cluster->release_player( "Kilgore Trout" );
+    AssertThat( store->values[ "cluster:player:Kilgore Trout" ], Equals( "there" ) );
+  }
+
+  It( keeps_players_while_the_store_does_not_answer )
+  {
+    add_player_at( "Kilgore Trout", 10 );
+    store->is_answering = false;
+    AssertThat( tick(), IsEmpty() );
+  }
+
+  It( keeps_players_when_the_other_node_has_no_address )
+  {
+    store->values[ "cluster:zone:1:0" ] = "gone";
+    add_player_at( "Kilgore Trout", zone_size + 10 );
+    AssertThat( tick(), IsEmpty() );
+  }
+
+  It( puts_handed_off_ships_where_they_left )
+  {
+    store->values[ "cluster:zone:1:0" ] = "there";
+    add_player_at( "Kilgore Trout", zone_size + 10 );
+    tick();
+
+    yarrr::PhysicalParameters ship;
+    AssertThat( cluster->take_handed_off_ship( "Kilgore Trout", ship ), Equals( true ) );
+    AssertThat( ship.coordinate, Equals( yarrr::Coordinate( zone_size + 10, 0 ) ) );
+    AssertThat( cluster->take_handed_off_ship( "Kilgore Trout", ship ), Equals( false ) );
+  }
+
+  It( does_not_let_a_player_log_in_to_the_world_twice_in_the_cluster )
+  {
+    services->reset_world( cluster.get() );
+    store->values[ "cluster:player:Kilgore Trout" ] = "there";
+    log_in( "Kilgore Trout" );
+    AssertThat( services->players, IsEmpty() );
+  }
+
+  It( tells_a_refused_client_where_its_player_is_logged_in )
+  {
+    services->reset_world( cluster.get() );
+    store->values[ "cluster:player:Kilgore Trout" ] = "there";
+    log_in( "Kilgore Trout" );
+    AssertThat( connections.back()->get_entity< yarrr::ChatMessage >()->message(), Contains( "127.0.0.1:2002" ) );
+  }
+
+  It( releases_the_player_when_it_logs_out_of_the_world )
+  {
+    services->reset_world( cluster.get() );
+    log_in( "Kilgore Trout" );
+    AssertThat( store->values[ "cluster:player:Kilgore Trout" ], Equals( "here" ) );
+
+    services->local_event_dispatcher.dispatcher.dispatch(
+        yarrrs::PlayerLoggedOut( connections.back()->connection->id ) );
+    AssertThat( store->values.count( "cluster:player:Kilgore Trout" ), Equals( 0u ) );
+  }
+
+  const yarrr::Coordinate::type zone_size{ 100000 };
+  std::unique_ptr< test::Services > services;
+  std::unique_ptr< InMemoryStore > store;
+  std::unique_ptr< yarrrs::Cluster > cluster;
+  std::unique_ptr< yarrrs::WorkerPool > workers;
+  std::unique_ptr< yarrrs::Zones > zones;
+  std::vector< test::Services::PlayerBundle::Pointer > bundles;
+  std::vector< std::unique_ptr< test::Connection > > connections;
+};
+
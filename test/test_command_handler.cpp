@@ -25,7 +25,7 @@ Describe( a_command_handler )
           was_a_command_handler_executed = true;
           passed_command = &command;
           passed_player = &player;
-          return yarrrs::CommandHandler::Result( command_result, command_result_message );
+          return yarrrs::CommandHandler::Result::failure( command_result_message );
         } );
 
 
@@ -34,7 +34,7 @@ Describe( a_command_handler )
         [ this ]( const yarrr::Command&, yarrrs::Player& ) -> yarrrs::CommandHandler::Result
         {
           was_another_command_handler_executed = true;
-          return yarrrs::CommandHandler::Result( command_result, command_result_message );
+          return yarrrs::CommandHandler::Result::failure( command_result_message );
         } );
 
     player.reset( new yarrrs::Player( players, "a player", connection.wrapper, dummy ) );
@@ -65,17 +65,31 @@ Describe( a_command_handler )
   It ( returns_the_handlers_result )
   {
     const auto result( command_handler->execute( a_command, *player ) );
-    AssertThat( std::get<0>( result ), Equals( command_result ) );
-    AssertThat( std::get<1>( result ), Equals( command_result_message ) );
+    AssertThat( result.did_succeed(), Equals( false ) );
+    AssertThat( result.message(), Equals( command_result_message ) );
+  }
+
+  It ( replaces_the_handler_registered_earlier_for_the_same_command )
+  {
+    command_handler->register_handler( a_command.command(),
+        []( const yarrr::Command&, yarrrs::Player& ) -> yarrrs::CommandHandler::Result
+        {
+          return yarrrs::CommandHandler::Result::success();
+        } );
+
+    const auto result( command_handler->execute( a_command, *player ) );
+    AssertThat( result.did_succeed(), Equals( true ) );
+    AssertThat( result.message(), IsEmpty() );
+    AssertThat( was_a_command_handler_executed, Equals( false ) );
   }
 
   It ( returns_failed_result_for_an_unknown_command )
   {
     const std::string command_name( "an unknown command" );
     const auto result( command_handler->execute( yarrr::Command( { command_name } ), *player ) );
-    AssertThat( std::get< 0 >( result ), Equals( false ) );
-    AssertThat( std::get< 1 >( result ), Contains( "Unknown command" ) );
-    AssertThat( std::get< 1 >( result ), Contains( command_name ) );
+    AssertThat( result.did_succeed(), Equals( false ) );
+    AssertThat( result.message(), Contains( "Unknown command" ) );
+    AssertThat( result.message(), Contains( command_name ) );
   }
 
   std::unique_ptr< test::Services > services;
@@ -92,7 +106,6 @@ Describe( a_command_handler )
   yarrrs::CommandHandler dummy;
   std::unique_ptr< yarrrs::Player > player;
   yarrrs::Player* passed_player;
-  const bool command_result{ true };
   const std::string command_result_message{ "command result message" };
 };
 
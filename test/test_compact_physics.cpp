@@ -0,0 +1,159 @@
+#include "../src/compact_physics.hpp"
+#include "../src/object_updates.hpp"
+#include "test_services.hpp"
+#include <yarrr/command.hpp>
+#include <yarrr/object.hpp>
+#include <yarrr/object_container.hpp>
+#include <yarrr/test_connection.hpp>
+#include <igloo/igloo_alt.h>
+
+#include <cstdlib>
+
+using namespace igloo;
+
+Describe( a_compact_physics_encoding )
+{
+  void SetUp()
+  {
+    encoding = std::make_unique< yarrrs::CompactPhysics >( quantization );
+    physical_parameters = yarrr::PhysicalParameters();
+    physical_parameters.coordinate = yarrr::Coordinate( 123457, -98765 );
+    physical_parameters.velocity = yarrr::Coordinate( 1001, -399 );
+    physical_parameters.orientation = 725;
+    physical_parameters.angular_velocity = -40;
+    physical_parameters.integrity = 87;
+    physical_parameters.timestamp = 1234567890;
+  }
+
+  std::string payload_of( yarrr::Data&& message )
+  {
+    connection.connection->send( std::move( message ) );
+    auto command( connection.get_entity< yarrr::Command >() );
+    AssertThat( command->command(), Equals( yarrrs::CompactPhysics::message_name ) );
+    return command->parameters().back();
+  }
+
+  yarrr::PhysicalParameters round_trip( const yarrr::PhysicalParameters& original )
+  {
+    yarrr::Object::Id decoded_id( 0 );
+    yarrr::PhysicalParameters decoded;
+    AssertThat( encoding->decode( payload_of( encoding->encode( id, original ) ), decoded_id, decoded ), Equals( true ) );
+    AssertThat( decoded_id, Equals( id ) );
+    return decoded;
+  }
+
+  It( keeps_the_position_within_half_a_step )
+  {
+    const yarrr::PhysicalParameters decoded( round_trip( physical_parameters ) );
+    AssertThat( std::abs( decoded.coordinate.x - physical_parameters.coordinate.x ) <= quantization.position_step / 2, Equals( true ) );
+    AssertThat( std::abs( decoded.coordinate.y - physical_parameters.coordinate.y ) <= quantization.position_step / 2, Equals( true ) );
+  }
+
+  It( keeps_positions_far_away_from_the_origin )
+  {
+    physical_parameters.coordinate = yarrr::Coordinate( -50000000000ll, 70000000000ll );
+    const yarrr::PhysicalParameters decoded( round_trip( physical_parameters ) );
+    AssertThat( decoded.coordinate.x, Equals( physical_parameters.coordinate.x ) );
+    AssertThat( decoded.coordinate.y, Equals( physical_parameters.coordinate.y ) );
+  }
+
+  It( keeps_the_velocity_within_half_a_step )
+  {
+    const yarrr::PhysicalParameters decoded( round_trip( physical_parameters ) );
+    AssertThat( std::abs( decoded.velocity.x - physical_parameters.velocity.x ) <= quantization.velocity_step / 2, Equals( true ) );
+    AssertThat( std::abs( decoded.velocity.y - physical_parameters.velocity.y ) <= quantization.velocity_step / 2, Equals( true ) );
+  }
+
+  It( keeps_the_orientation_as_a_fraction_of_a_turn )
+  {
+    AssertThat( round_trip( physical_parameters ).orientation, Equals( physical_parameters.orientation ) );
+
+    physical_parameters.orientation = -quantization.angle_per_turn / 4;
+    AssertThat( round_trip( physical_parameters ).orientation, Equals( quantization.angle_per_turn * 3 / 4 ) );
+  }
+
+  It( keeps_the_rest_of_the_state_exact )
+  {
+    const yarrr::PhysicalParameters decoded( round_trip( physical_parameters ) );
+    AssertThat( decoded.angular_velocity, Equals( physical_parameters.angular_velocity ) );
+    AssertThat( decoded.integrity, Equals( physical_parameters.integrity ) );
+    AssertThat( decoded.timestamp, Equals( physical_parameters.timestamp ) );
+  }
+
+  It( leaves_out_the_velocities_of_still_objects )
+  {
+    const size_t moving_size( encoding->encode( id, physical_parameters ).size() );
+    physical_parameters.velocity = yarrr::Coordinate();
+    physical_parameters.angular_velocity = 0;
+    AssertThat( encoding->encode( id, physical_parameters ).size() < moving_size, Equals( true ) );
+    AssertThat( round_trip( physical_parameters ).velocity.x, Equals( 0 ) );
+  }
+
+  It( rejects_truncated_payloads )
+  {
+    const std::string payload( payload_of( encoding->encode( id, physical_parameters ) ) );
+    yarrr::Object::Id decoded_id( 0 );
+    yarrr::PhysicalParameters decoded;
+    AssertThat( encoding->decode( payload.substr( 0, payload.size() - 1 ), decoded_id, decoded ), Equals( false ) );
+  }
+
+  test::Connection connection;
+  const yarrrs::CompactPhysics::Quantization quantization{ 16, 4, 1440 };
+  const yarrr::Object::Id id{ 4242 };
+  yarrr::PhysicalParameters physical_parameters;
+  std::unique_ptr< yarrrs::CompactPhysics > encoding;
+};
+
+Describe( a_player_with_compact_physics )
+{
+  void SetUp()
+  {
+    services = std::make_unique< test::Services >();
+    auto connection( std::make_unique< test::Connection >() );
+    const int connection_id( connection->connection->id );
+    services->players[ connection_id ] = std::make_unique< yarrrs::Player >(
+        services->players,
+        "Kilgore Trout",
+        connection->wrapper,
+        services->command_handler,
+        yarrrs::Capabilities{ yarrrs::Capabilities::compact_physics } );
+    player_connection = std::move( connection );
+
+    yarrr::Object::Pointer ship( new yarrr::Object() );
+    ship->add_behavior( std::make_unique< yarrr::PhysicalBehavior >() );
+    physical_parameters = &yarrr::component_of< yarrr::PhysicalBehavior >( *ship ).physical_parameters;
+    services->objects.add_object( std::move( ship ) );
+    player_connection->flush_connection();
+  }
+
+  void TearDown()
+  {
+    services->players.clear();
+    player_connection.reset();
+    services.reset();
+  }
+
+  It( gets_the_first_update_of_an_object_in_full )
+  {
+    yarrrs::send_object_updates( services->objects, services->players, priorities, compact_physics );
+    AssertThat( player_connection->has_entity< yarrr::ObjectUpdate >(), Equals( true ) );
+  }
+
+  It( gets_corrections_in_the_compact_encoding )
+  {
+    yarrrs::send_object_updates( services->objects, services->players, priorities, compact_physics );
+    player_connection->flush_connection();
+
+    physical_parameters->coordinate.x += 1000000;
+    yarrrs::send_object_updates( services->objects, services->players, priorities, compact_physics );
+    AssertThat( player_connection->has_entity< yarrr::ObjectUpdate >(), Equals( false ) );
+    AssertThat( player_connection->get_entity< yarrr::Command >()->command(), Equals( yarrrs::CompactPhysics::message_name ) );
+  }
+
+  std::unique_ptr< test::Services > services;
+  std::unique_ptr< test::Connection > player_connection;
+  yarrr::PhysicalParameters* physical_parameters;
+  const yarrrs::UpdatePriorities priorities{ yarrrs::UpdatePriorities::from_configuration() };
+  const yarrrs::CompactPhysics compact_physics{ yarrrs::CompactPhysics::Quantization::from_configuration() };
+};
+
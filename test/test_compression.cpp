@@ -0,0 +1,145 @@
+#include "../src/compression.hpp"
+#include "../src/capabilities.hpp"
+#include "../src/player.hpp"
+#include "test_services.hpp"
+#include <yarrr/chat_message.hpp>
+#include <yarrr/command.hpp>
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+namespace
+{
+
+yarrr::Data
+data_from( const std::string& text )
+{
+  return yarrr::Data( std::begin( text ), std::end( text ) );
+}
+
+yarrr::Data
+round_trip( const yarrr::Data& original )
+{
+  yarrr::Data decompressed;
+  AssertThat( yarrrs::lz::decompress( yarrrs::lz::compress( original ), decompressed ), Equals( true ) );
+  return decompressed;
+}
+
+}
+
+Describe( an_lz_codec )
+{
+  It ( restores_an_empty_buffer )
+  {
+    AssertThat( round_trip( yarrr::Data() ), IsEmpty() );
+  }
+
+  It ( restores_short_buffers_without_matches )
+  {
+    const auto original( data_from( "abc" ) );
+    AssertThat( round_trip( original ), Equals( original ) );
+  }
+
+  It ( restores_repetitive_buffers )
+  {
+    const auto original( data_from( std::string( 1000, 'a' ) + "/mission request /mission request /mission list" ) );
+    AssertThat( round_trip( original ), Equals( original ) );
+  }
+
+  It ( shrinks_repetitive_buffers )
+  {
+    const auto original( data_from( std::string( 1000, 'a' ) ) );
+    AssertThat( yarrrs::lz::compress( original ).size(), IsLessThan( 100u ) );
+  }
+
+  It ( restores_buffers_with_every_byte_value )
+  {
+    yarrr::Data original;
+    for ( int i( 0 ); i < 4096; ++i )
+    {
+      original.push_back( static_cast< char >( ( i * 7 ) % 256 ) );
+    }
+
+    AssertThat( round_trip( original ), Equals( original ) );
+  }
+
+  It ( rejects_truncated_input )
+  {
+    auto compressed( yarrrs::lz::compress( data_from( std::string( 1000, 'a' ) + "some literals" ) ) );
+    compressed.resize( compressed.size() / 2 );
+    yarrr::Data decompressed;
+    AssertThat( yarrrs::lz::decompress( compressed, decompressed ), Equals( false ) );
+  }
+};
+
+Describe( a_compressor )
+{
+  It ( leaves_messages_below_the_threshold_untouched )
+  {
+    const auto message( data_from( std::string( threshold - 1, 'a' ) ) );
+    AssertThat( compressor.compress_if_worth_it( yarrr::Data( message ) ), Equals( message ) );
+  }
+
+  It ( leaves_messages_untouched_if_compression_does_not_make_them_smaller )
+  {
+    yarrr::Data message;
+    for ( size_t i( 0 ); i < threshold; ++i )
+    {
+      message.push_back( static_cast< char >( ( i * 101 ) % 251 ) );
+    }
+
+    AssertThat( compressor.compress_if_worth_it( yarrr::Data( message ) ), Equals( message ) );
+  }
+
+  It ( shrinks_large_messages )
+  {
+    const auto message( data_from( std::string( threshold * 4, 'a' ) ) );
+    AssertThat( compressor.compress_if_worth_it( yarrr::Data( message ) ).size(), IsLessThan( message.size() ) );
+  }
+
+  const size_t threshold{ 128 };
+  const yarrrs::Compressor compressor{ threshold };
+};
+
+Describe( a_player_with_compression )
+{
+  void SetUp()
+  {
+    services = std::make_unique< test::Services >();
+    player = std::make_unique< yarrrs::Player >(
+        players,
+        "Kilgore Trout",
+        connection.wrapper,
+        services->command_handler,
+        yarrrs::Capabilities{ yarrrs::Capabilities::lz_compression } );
+    connection.flush_connection();
+  }
+
+  It ( sends_large_messages_compressed )
+  {
+    const yarrr::ChatMessage message( std::string( 4096, 'a' ), "server" );
+    player->send( message.serialize() );
+
+    AssertThat( connection.has_entity< yarrr::Command >(), Equals( true ) );
+    auto command( connection.get_entity< yarrr::Command >() );
+    AssertThat( command->command(), Equals( yarrrs::Compressor::compressed_message ) );
+    AssertThat( command->parameters(), HasLength( 1 ) );
+
+    const auto& payload( command->parameters().back() );
+    yarrr::Data decompressed;
+    AssertThat( yarrrs::lz::decompress( yarrr::Data( std::begin( payload ), std::end( payload ) ), decompressed ), Equals( true ) );
+    AssertThat( decompressed, Equals( message.serialize() ) );
+  }
+
+  It ( sends_small_messages_as_they_are )
+  {
+    player->send( yarrr::ChatMessage( "hello", "server" ).serialize() );
+    AssertThat( connection.has_entity< yarrr::ChatMessage >(), Equals( true ) );
+  }
+
+  std::unique_ptr< test::Services > services;
+  yarrrs::Player::Container players;
+  test::Connection connection;
+  std::unique_ptr< yarrrs::Player > player;
+};
+
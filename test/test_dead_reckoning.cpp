@@ -0,0 +1,130 @@
+#include "../src/dead_reckoning.hpp"
+#include <thetime/clock.hpp>
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( a_dead_reckoning )
+{
+  void SetUp()
+  {
+    dead_reckoning = std::make_unique< yarrrs::DeadReckoning >( tolerances );
+    moving = yarrr::PhysicalParameters();
+    moving.velocity.x = 1000;
+    moving.angular_velocity = 100;
+    dead_reckoning->is_update_needed( id, moving, 0 );
+  }
+
+  yarrr::PhysicalParameters a_tick_later( const yarrr::PhysicalParameters& physical_parameters, int ticks = 1 )
+  {
+    yarrr::PhysicalParameters later( physical_parameters );
+    later.timestamp += ticks * tick_length;
+    later.coordinate.x += ticks * 100;
+    later.orientation += ticks * 10;
+    return later;
+  }
+
+  It( needs_the_first_update_of_an_object )
+  {
+    AssertThat( dead_reckoning->is_update_needed( id + 1, moving, 1 ), Equals( true ) );
+  }
+
+  It( calls_the_first_update_of_an_object_a_keyframe )
+  {
+    AssertThat( dead_reckoning->update_needed( id + 1, moving, 1 ), Equals( yarrrs::DeadReckoning::keyframe ) );
+  }
+
+  It( calls_an_update_after_a_drift_a_correction )
+  {
+    yarrr::PhysicalParameters turned( a_tick_later( moving ) );
+    turned.coordinate.y += tolerances.position + 1;
+    AssertThat( dead_reckoning->update_needed( id, turned, 1 ), Equals( yarrrs::DeadReckoning::correction ) );
+  }
+
+  It( extrapolates_along_the_velocities )
+  {
+    const yarrr::PhysicalParameters extrapolated( yarrrs::DeadReckoning::extrapolate( moving, tick_length ) );
+    AssertThat( extrapolated.coordinate.x, Equals( 100 ) );
+    AssertThat( extrapolated.orientation, Equals( 10 ) );
+    AssertThat( extrapolated.timestamp, Equals( tick_length ) );
+  }
+
+  It( does_not_need_updates_while_the_object_follows_the_extrapolation )
+  {
+    AssertThat( dead_reckoning->is_update_needed( id, a_tick_later( moving ), 1 ), Equals( false ) );
+    AssertThat( dead_reckoning->is_update_needed( id, a_tick_later( moving, 2 ), 2 ), Equals( false ) );
+  }
+
+  It( needs_an_update_when_the_position_drifts_beyond_the_tolerance )
+  {
+    yarrr::PhysicalParameters turned( a_tick_later( moving ) );
+    turned.coordinate.y += tolerances.position + 1;
+    AssertThat( dead_reckoning->is_update_needed( id, turned, 1 ), Equals( true ) );
+  }
+
+  It( needs_an_update_when_the_orientation_drifts_beyond_the_tolerance )
+  {
+    yarrr::PhysicalParameters spun( a_tick_later( moving ) );
+    spun.orientation -= tolerances.orientation + 1;
+    AssertThat( dead_reckoning->is_update_needed( id, spun, 1 ), Equals( true ) );
+  }
+
+  It( needs_an_update_when_the_integrity_changes )
+  {
+    yarrr::PhysicalParameters hit( a_tick_later( moving ) );
+    hit.integrity -= 1;
+    AssertThat( dead_reckoning->is_update_needed( id, hit, 1 ), Equals( true ) );
+  }
+
+  It( extrapolates_from_the_last_update_needed )
+  {
+    yarrr::PhysicalParameters stopped( a_tick_later( moving ) );
+    stopped.coordinate.y += tolerances.position + 1;
+    stopped.velocity.x = 0;
+    stopped.angular_velocity = 0;
+    dead_reckoning->is_update_needed( id, stopped, 1 );
+
+    stopped.timestamp += tick_length;
+    AssertThat( dead_reckoning->is_update_needed( id, stopped, 2 ), Equals( false ) );
+  }
+
+  It( needs_a_keyframe_after_the_keyframe_interval )
+  {
+    for ( int tick( 1 ); tick < tolerances.keyframe_ticks; ++tick )
+    {
+      AssertThat( dead_reckoning->is_update_needed( id, a_tick_later( moving, tick ), tick ), Equals( false ) );
+    }
+
+    AssertThat( dead_reckoning->update_needed(
+          id, a_tick_later( moving, tolerances.keyframe_ticks ), tolerances.keyframe_ticks ),
+        Equals( yarrrs::DeadReckoning::keyframe ) );
+  }
+
+  It( counts_the_keyframe_interval_in_ticks_not_in_calls )
+  {
+    AssertThat( dead_reckoning->update_needed(
+          id, a_tick_later( moving, tolerances.keyframe_ticks ), tolerances.keyframe_ticks ),
+        Equals( yarrrs::DeadReckoning::keyframe ) );
+  }
+
+  It( measures_the_orientation_drift_around_a_full_turn )
+  {
+    yarrr::PhysicalParameters still;
+    dead_reckoning->is_update_needed( id + 1, still, 0 );
+    still.orientation = tolerances.angle_per_turn - 1;
+    AssertThat( dead_reckoning->is_update_needed( id + 1, still, 1 ), Equals( false ) );
+  }
+
+  It( needs_an_update_of_a_forgotten_object )
+  {
+    dead_reckoning->forget( id );
+    AssertThat( dead_reckoning->is_update_needed( id, a_tick_later( moving ), 1 ), Equals( true ) );
+  }
+
+  const yarrrs::DeadReckoning::Tolerances tolerances{ 50, 20, 5, 1440 };
+  const int64_t tick_length{ the::time::Clock::ticks_per_second / 10 };
+  const yarrr::Object::Id id{ 42 };
+  yarrr::PhysicalParameters moving;
+  std::unique_ptr< yarrrs::DeadReckoning > dead_reckoning;
+};
+
@@ -0,0 +1,68 @@
+#include "../src/export_scheduler.hpp"
+#include "test_services.hpp"
+
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( an_export_scheduler )
+{
+  void SetUp()
+  {
+    services = std::make_unique< test::Services >();
+    refreshes = 0;
+    scheduler = std::make_unique< yarrrs::ExportScheduler >(
+        [ this ]() { ++refreshes; },
+        interval );
+  }
+
+  void TearDown()
+  {
+    scheduler.reset();
+    services.reset();
+  }
+
+  void tick( int64_t ticks )
+  {
+    for ( int64_t i( 0 ); i < ticks; ++i )
+    {
+      scheduler->tick();
+    }
+  }
+
+  It( does_not_refresh_while_nobody_reads )
+  {
+    tick( interval * 3 );
+    AssertThat( refreshes, Equals( 0 ) );
+  }
+
+  It( refreshes_before_the_first_reading )
+  {
+    scheduler->before_reading();
+    AssertThat( refreshes, Equals( 1 ) );
+  }
+
+  It( refreshes_at_most_once_in_an_interval )
+  {
+    scheduler->before_reading();
+    tick( interval - 1 );
+    scheduler->before_reading();
+    AssertThat( refreshes, Equals( 1 ) );
+
+    tick( 1 );
+    scheduler->before_reading();
+    AssertThat( refreshes, Equals( 2 ) );
+  }
+
+  It( counts_the_refreshes )
+  {
+    scheduler->before_reading();
+    AssertThat( services->metrics.counter( "yarrr_object_exports_total", "" ).get(), Equals( 1.0 ) );
+  }
+
+  const int64_t interval{ 3 };
+  int refreshes;
+  std::unique_ptr< test::Services > services;
+  std::unique_ptr< yarrrs::ExportScheduler > scheduler;
+};
+
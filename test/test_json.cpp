@@ -0,0 +1,74 @@
+#include "../src/json.hpp"
+
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( a_json_scanner )
+{
+  std::string value_at( const std::string& path )
+  {
+    yarrrs::json::Slice slice;
+    if ( !yarrrs::json::find( model, path, slice ) )
+    {
+      return "not found";
+    }
+
+    return model.substr( slice.begin, slice.end - slice.begin );
+  }
+
+  It( finds_the_whole_text_at_the_empty_path )
+  {
+    AssertThat( value_at( "" ), Equals( model ) );
+  }
+
+  It( finds_values_at_dot_separated_paths )
+  {
+    AssertThat( value_at( "objects.12" ), Equals( "{ \"x\": 1, \"tags\": [ \"a\", \"}\" ] }" ) );
+    AssertThat( value_at( "objects.12.x" ), Equals( "1" ) );
+    AssertThat( value_at( "clock" ), Equals( "42" ) );
+  }
+
+  It( skips_brackets_and_quotes_inside_strings )
+  {
+    AssertThat( value_at( "objects.7" ), Equals( "\"a \\\" quote }\"" ) );
+    AssertThat( value_at( "objects.13" ), Equals( "null" ) );
+  }
+
+  It( does_not_find_missing_paths )
+  {
+    AssertThat( value_at( "objects.99" ), Equals( "not found" ) );
+    AssertThat( value_at( "clock.x" ), Equals( "not found" ) );
+  }
+
+  It( lists_the_members_of_an_object )
+  {
+    std::vector< std::string > keys;
+    AssertThat( yarrrs::json::for_each_member( model, yarrrs::json::Slice{ 0, model.size() },
+          [ &keys ]( const std::string& key, const yarrrs::json::Slice& ) { keys.push_back( key ); } ),
+        Equals( true ) );
+    AssertThat( keys, Equals( std::vector< std::string >{ "objects", "clock" } ) );
+  }
+
+  It( refuses_truncated_text )
+  {
+    const std::string truncated( "{ \"objects\": { \"12\": [ 1, 2 " );
+    size_t position( 0 );
+    AssertThat( yarrrs::json::skip_value( truncated, position ), Equals( false ) );
+  }
+
+  It( quotes_strings )
+  {
+    AssertThat( yarrrs::json::quoted( "a \"b\"\n" ), Equals( "\"a \\\"b\\\"\\n\"" ) );
+  }
+
+  It( escapes_the_other_control_characters_of_strings )
+  {
+    AssertThat( yarrrs::json::quoted( std::string( "a\x01\x1f" ) + '\0' ), Equals( "\"a\\u0001\\u001f\\u0000\"" ) );
+  }
+
+  const std::string model{
+    "{ \"objects\": { \"12\": { \"x\": 1, \"tags\": [ \"a\", \"}\" ] }, "
+    "\"7\": \"a \\\" quote }\", \"13\": null }, \"clock\": 42 }" };
+};
+
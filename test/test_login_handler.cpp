@@ -1,4 +1,5 @@
 #include "../src/login_handler.hpp"
+#include "../src/capabilities.hpp"
 #include "test_services.hpp"
 #include <yarrr/test_connection.hpp>
 #include <yarrr/test_db.hpp>
@@ -31,10 +32,12 @@ Describe( a_login_handler )
     dispatcher.register_listener< yarrrs::PlayerLoggedIn >(
         [
         &was_dispatched = was_player_logged_in,
-        &player_name = last_player_logged_in ]( const yarrrs::PlayerLoggedIn& login )
+        &player_name = last_player_logged_in,
+        &capabilities = last_capabilities ]( const yarrrs::PlayerLoggedIn& login )
         {
           was_dispatched = true;
           player_name = login.name;
+          capabilities = login.capabilities;
         });
 
     was_player_logged_out = false;
@@ -231,6 +234,60 @@ Describe( a_login_handler )
     assert_login_error_was_sent();
   }
 
+  It( answers_capability_negotiation_with_the_supported_subset )
+  {
+    connection->wrapper.dispatch( yarrr::Command{ {
+        yarrrs::Capabilities::negotiation,
+        yarrrs::Capabilities::lz_compression,
+        "an unknown capability" } } );
+
+    AssertThat( connection->has_entity< yarrr::Command >(), Equals( true ) );
+    auto command( connection->get_entity< yarrr::Command >() );
+    AssertThat( command->command(), Equals( yarrrs::Capabilities::negotiation ) );
+    AssertThat( command->parameters(), HasLength( 1 ) );
+    AssertThat( command->parameters(), Contains( yarrrs::Capabilities::lz_compression ) );
+  }
+
+  It( passes_the_negotiated_capabilities_with_player_logged_in )
+  {
+    connection->wrapper.dispatch( yarrr::Command{ {
+        yarrrs::Capabilities::negotiation,
+        yarrrs::Capabilities::lz_compression } } );
+    connection->wrapper.dispatch( registration_request );
+    AssertThat( last_capabilities.has( yarrrs::Capabilities::lz_compression ), Equals( true ) );
+  }
+
+  void pause_logins()
+  {
+    login_handler = std::make_unique< yarrrs::LoginHandler >(
+        connection->wrapper,
+        dispatcher,
+        []() { return false; } );
+  }
+
+  It( refuses_registration_while_logins_are_paused )
+  {
+    pause_logins();
+    connection->wrapper.dispatch( registration_request );
+    AssertThat( was_player_logged_in, Equals( false ) );
+    AssertThat( services->modell_container.exists( "player", username ), Equals( false ) );
+    assert_login_error_was_sent();
+  }
+
+  It( does_not_send_authentication_request_while_logins_are_paused )
+  {
+    set_up_player_modell();
+    pause_logins();
+    connection->wrapper.dispatch( login_request );
+    assert_login_error_was_sent();
+  }
+
+  It( uses_no_capabilities_without_negotiation )
+  {
+    connection->wrapper.dispatch( registration_request );
+    AssertThat( last_capabilities.names(), IsEmpty() );
+  }
+
   std::unique_ptr< test::Services > services;
 
   std::unique_ptr< test::Connection > connection;
@@ -243,6 +300,7 @@ Describe( a_login_handler )
   const std::string auth_token_sent_by_client{ "auth_token" };
   bool was_player_logged_in;
   std::string last_player_logged_in;
+  yarrrs::Capabilities last_capabilities;
   bool was_player_logged_out;
 
   yarrr::Command registration_request;
@@ -0,0 +1,185 @@
+#include "../src/lua_cache.hpp"
+
+#include <igloo/igloo_alt.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+using namespace igloo;
+
+namespace
+{
+
+void
+write_file( const std::string& path, const std::string& content )
+{
+  std::ofstream file( path, std::ios::binary );
+  file << content;
+}
+
+std::string
+read_file( const std::string& path )
+{
+  std::ifstream file( path, std::ios::binary );
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+bool
+exists( const std::string& path )
+{
+  struct stat status;
+  return stat( path.c_str(), &status ) == 0;
+}
+
+}
+
+Describe( a_lua_cache )
+{
+  void SetUp()
+  {
+    char root_template[] = "/tmp/yarrrs_lua_cache_XXXXXX";
+    root = std::string( mkdtemp( root_template ) ) + "/";
+    sources = root + "sources/";
+    cache_folder = root + "cache/";
+    mkdir( sources.c_str(), 0755 );
+    mkdir( ( sources + "missions/" ).c_str(), 0755 );
+    write_file( sources + "main.lua", main_source );
+    write_file( sources + "missions/tutorial.lua", "return { name = 'tutorial' }\n" );
+    write_file( sources + "ships.json", "{}" );
+  }
+
+  void TearDown()
+  {
+    std::system( ( "rm -rf " + root ).c_str() );
+  }
+
+  It( mirrors_lua_sources_as_bytecode )
+  {
+    yarrrs::LuaCache cache( cache_folder );
+    const std::string mirrored( cache.mirror( sources ) );
+    AssertThat( mirrored == sources, Equals( false ) );
+    AssertThat( read_file( mirrored + "main.lua" ), StartsWith( "\x1bLua" ) );
+    AssertThat( read_file( mirrored + "missions/tutorial.lua" ), StartsWith( "\x1bLua" ) );
+    AssertThat( cache.statistics().compiled, Equals( 2u ) );
+  }
+
+  It( links_other_files )
+  {
+    yarrrs::LuaCache cache( cache_folder );
+    AssertThat( read_file( cache.mirror( sources ) + "ships.json" ), Equals( "{}" ) );
+    AssertThat( cache.statistics().linked, Equals( 1u ) );
+  }
+
+  It( reuses_the_bytecode_of_unchanged_sources )
+  {
+    {
+      yarrrs::LuaCache cache( cache_folder );
+      cache.mirror( sources );
+    }
+
+    yarrrs::LuaCache cache( cache_folder );
+    cache.mirror( sources );
+    AssertThat( cache.statistics().compiled, Equals( 0u ) );
+    AssertThat( cache.statistics().reused, Equals( 2u ) );
+  }
+
+  It( compiles_changed_sources_again )
+  {
+    {
+      yarrrs::LuaCache cache( cache_folder );
+      cache.mirror( sources );
+    }
+
+    write_file( sources + "main.lua", main_source + "x = 2\n" );
+    yarrrs::LuaCache cache( cache_folder );
+    cache.mirror( sources );
+    AssertThat( cache.statistics().compiled, Equals( 1u ) );
+    AssertThat( cache.statistics().reused, Equals( 1u ) );
+  }
+
+  It( leaves_sources_not_compiling_to_the_engine )
+  {
+    write_file( sources + "broken.lua", "function (" );
+    yarrrs::LuaCache cache( cache_folder );
+    AssertThat( read_file( cache.mirror( sources ) + "broken.lua" ), Equals( "function (" ) );
+  }
+
+  It( mirrors_every_source_folder_apart )
+  {
+    const std::string other_sources( root + "other_sources/" );
+    mkdir( other_sources.c_str(), 0755 );
+    write_file( other_sources + "main.lua", "x = 3\n" );
+
+    yarrrs::LuaCache cache( cache_folder );
+    const std::string mirrored( cache.mirror( sources ) );
+    const std::string other_mirrored( cache.mirror( other_sources ) );
+    AssertThat( mirrored == other_mirrored, Equals( false ) );
+    AssertThat( read_file( mirrored + "ships.json" ), Equals( "{}" ) );
+    AssertThat( exists( other_mirrored + "ships.json" ), Equals( false ) );
+    AssertThat( cache.statistics().compiled, Equals( 3u ) );
+  }
+
+  It( uses_the_sources_when_they_can_not_be_mirrored )
+  {
+    yarrrs::LuaCache cache( cache_folder );
+    AssertThat( cache.mirror( root + "missing/" ), Equals( root + "missing/" ) );
+  }
+
+  It( removes_the_mirror_with_the_cache )
+  {
+    std::string mirrored;
+    {
+      yarrrs::LuaCache cache( cache_folder );
+      mirrored = cache.mirror( sources );
+    }
+
+    AssertThat( exists( mirrored ), Equals( false ) );
+    AssertThat( exists( cache_folder + "bytecode/" ), Equals( true ) );
+  }
+
+  It( keeps_the_mirror_in_a_cache_folder_given_without_a_slash )
+  {
+    yarrrs::LuaCache cache( root + "cache" );
+    AssertThat( cache.mirror( sources ).find( cache_folder ), Equals( 0u ) );
+  }
+
+  It( removes_the_bytecode_no_mirror_uses )
+  {
+    {
+      yarrrs::LuaCache cache( cache_folder );
+      cache.mirror( sources );
+    }
+
+    const std::string unused( cache_folder + "bytecode/unused.luac" );
+    write_file( unused, "\x1bLua" );
+    const utimbuf long_ago{ 0, 0 };
+    utime( unused.c_str(), &long_ago );
+    {
+      yarrrs::LuaCache cache( cache_folder );
+      cache.mirror( sources );
+    }
+
+    AssertThat( exists( unused ), Equals( false ) );
+    yarrrs::LuaCache cache( cache_folder );
+    cache.mirror( sources );
+    AssertThat( cache.statistics().reused, Equals( 2u ) );
+  }
+
+  It( hashes_different_sources_differently )
+  {
+    AssertThat( yarrrs::LuaCache::hash_of( "x = 1" ) == yarrrs::LuaCache::hash_of( "x = 2" ), Equals( false ) );
+  }
+
+  const std::string main_source{ "x = 1\nfunction f() return x end\n" };
+  std::string root;
+  std::string sources;
+  std::string cache_folder;
+};
+
@@ -0,0 +1,71 @@
+#include "../src/metrics.hpp"
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( a_metrics_registry )
+{
+  void SetUp()
+  {
+    metrics = std::make_unique< yarrrs::Metrics >();
+  }
+
+  It ( starts_values_from_zero )
+  {
+    AssertThat( metrics->counter( "a_counter", "help" ).get(), Equals( 0.0 ) );
+  }
+
+  It ( returns_the_same_value_for_the_same_name_and_labels )
+  {
+    metrics->counter( "a_counter", "help" ).increment();
+    metrics->counter( "a_counter", "help" ).increment( 2.0 );
+    AssertThat( metrics->counter( "a_counter", "help" ).get(), Equals( 3.0 ) );
+  }
+
+  It ( keeps_values_with_different_labels_apart )
+  {
+    metrics->counter( "a_counter", "help", yarrrs::Metrics::label( "type", "chat" ) ).increment();
+    AssertThat( metrics->counter( "a_counter", "help", yarrrs::Metrics::label( "type", "model" ) ).get(), Equals( 0.0 ) );
+  }
+
+  It ( exports_help_and_type_of_a_family )
+  {
+    metrics->gauge( "a_gauge", "Some help." ).set( 5 );
+    AssertThat( metrics->export_text(), Contains( "# HELP a_gauge Some help.\n" ) );
+    AssertThat( metrics->export_text(), Contains( "# TYPE a_gauge gauge\n" ) );
+    AssertThat( metrics->export_text(), Contains( "a_gauge 5\n" ) );
+  }
+
+  It ( exports_labels_in_braces )
+  {
+    metrics->counter( "a_counter", "help", yarrrs::Metrics::label( "type", "chat" ) ).increment( 12345678 );
+    AssertThat( metrics->export_text(), Contains( "a_counter{type=\"chat\"} 12345678\n" ) );
+  }
+
+  It ( escapes_quotes_in_label_values )
+  {
+    AssertThat( yarrrs::Metrics::label( "name", "a \"quoted\" name" ), Equals( "name=\"a \\\"quoted\\\" name\"" ) );
+  }
+
+  It ( stops_exporting_removed_values )
+  {
+    const std::string labels( yarrrs::Metrics::label( "player", "Kilgore Trout" ) );
+    metrics->gauge( "a_gauge", "help", labels ).set( 5 );
+    metrics->remove( "a_gauge", labels );
+    AssertThat( metrics->export_text().find( "Kilgore Trout" ), Equals( std::string::npos ) );
+  }
+
+  It ( counts_messages_and_bytes_of_traffic_by_type )
+  {
+    const yarrrs::Traffic traffic( *metrics, "chat" );
+    traffic.count( 10 );
+    traffic.count( 20 );
+
+    const std::string labels( yarrrs::Metrics::label( "type", "chat" ) );
+    AssertThat( metrics->counter( "yarrr_sent_messages_total", "", labels ).get(), Equals( 2.0 ) );
+    AssertThat( metrics->counter( "yarrr_sent_bytes_total", "", labels ).get(), Equals( 30.0 ) );
+  }
+
+  std::unique_ptr< yarrrs::Metrics > metrics;
+};
+
@@ -0,0 +1,122 @@
+#include "../src/mission_updater.hpp"
+#include "../src/player.hpp"
+#include "test_services.hpp"
+
+#include <yarrr/object_factory.hpp>
+#include <yarrr/mission.hpp>
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( a_mission_updater )
+{
+  void SetUp()
+  {
+    services = std::make_unique< test::Services >();
+    the::ctci::service< yarrr::ObjectFactory >().register_creator(
+        "ship", []() { return yarrr::Object::create(); } );
+    mission_updater = std::make_unique< yarrrs::MissionUpdater >( services->players, ticks_per_period );
+
+    player_bundle = services->log_in_player( "Kilgore Trout" );
+    player_bundle->player.start_mission( yarrr::Mission::Pointer( new yarrr::Mission() ) );
+    player_bundle->connection.flush_connection();
+  }
+
+  It ( updates_the_missions_of_a_logged_in_player_once_in_a_period )
+  {
+    for ( size_t i( 0 ); i < ticks_per_period; ++i )
+    {
+      mission_updater->tick();
+    }
+
+    AssertThat( player_bundle->connection.has_entity< yarrr::Mission >(), Equals( true ) );
+  }
+
+  It ( updates_only_a_slice_of_the_players_in_a_tick )
+  {
+    auto another_bundle( services->log_in_player( "Rabo Karabekian" ) );
+    auto& another_player( *services->players[ another_bundle->connection.connection->id ] );
+    another_player.start_mission( yarrr::Mission::Pointer( new yarrr::Mission() ) );
+    player_bundle->connection.flush_connection();
+    another_bundle->connection.flush_connection();
+
+    mission_updater->tick();
+    const bool was_first_player_updated( player_bundle->connection.has_entity< yarrr::Mission >() );
+    const bool was_another_player_updated( another_bundle->connection.has_entity< yarrr::Mission >() );
+    AssertThat( was_first_player_updated != was_another_player_updated, Equals( true ) );
+  }
+
+  It ( forgets_logged_out_players )
+  {
+    const int id( player_bundle->connection.connection->id );
+    services->local_event_dispatcher.dispatcher.dispatch( yarrrs::PlayerLoggedOut( id ) );
+    AssertThat( services->players, IsEmpty() );
+
+    //a player the updater was not told about, under the id of the logged out one
+    auto stranger( services->create_player( "Rabo Karabekian" ) );
+    stranger->player.start_mission( yarrr::Mission::Pointer( new yarrr::Mission() ) );
+    stranger->connection.flush_connection();
+    services->players[ id ] = stranger->take_player_ownership();
+
+    for ( size_t i( 0 ); i < ticks_per_period; ++i )
+    {
+      mission_updater->tick();
+    }
+
+    AssertThat( stranger->connection.has_entity< yarrr::Mission >(), Equals( false ) );
+    services->players.clear();
+  }
+
+  const size_t ticks_per_period{ 10 };
+  std::unique_ptr< test::Services > services;
+  std::unique_ptr< yarrrs::MissionUpdater > mission_updater;
+  std::unique_ptr< test::Services::PlayerBundle > player_bundle;
+};
+
+
+Describe( a_mission_updater_with_a_callback )
+{
+  void SetUp()
+  {
+    services = std::make_unique< test::Services >();
+    the::ctci::service< yarrr::ObjectFactory >().register_creator(
+        "ship", []() { return yarrr::Object::create(); } );
+    mission_updater = std::make_unique< yarrrs::MissionUpdater >(
+        services->players, ticks_per_period, [ this ]() { ++callbacks; } );
+  }
+
+  It ( calls_back_once_before_updating_the_missions_of_a_tick )
+  {
+    auto a_bundle( services->log_in_player( "Kilgore Trout" ) );
+    auto another_bundle( services->log_in_player( "Rabo Karabekian" ) );
+    auto third_bundle( services->log_in_player( "Eliot Rosewater" ) );
+
+    mission_updater->tick();
+    AssertThat( callbacks, Equals( 1 ) );
+  }
+
+  It ( does_not_call_back_when_nobody_is_updated )
+  {
+    mission_updater->tick();
+    AssertThat( callbacks, Equals( 0 ) );
+  }
+
+  It ( does_not_call_back_in_a_tick_of_an_empty_slot )
+  {
+    auto a_bundle( services->log_in_player( "Kilgore Trout" ) );
+    mission_updater->tick();
+    AssertThat( callbacks, Equals( 1 ) );
+
+    mission_updater->tick();
+    AssertThat( callbacks, Equals( 1 ) );
+
+    mission_updater->tick();
+    AssertThat( callbacks, Equals( 2 ) );
+  }
+
+  const size_t ticks_per_period{ 2 };
+  int callbacks{ 0 };
+  std::unique_ptr< test::Services > services;
+  std::unique_ptr< yarrrs::MissionUpdater > mission_updater;
+};
+
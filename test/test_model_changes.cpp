@@ -0,0 +1,57 @@
+#include "../src/model_changes.hpp"
+
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( model_changes )
+{
+  void SetUp()
+  {
+    changes = std::make_unique< yarrrs::ModelChanges >( 2 );
+  }
+
+  const yarrrs::ModelSnapshot::Snapshot& add( uint64_t version, const std::string& json )
+  {
+    snapshots.push_back( std::make_unique< yarrrs::ModelSnapshot::Snapshot >(
+          yarrrs::ModelSnapshot::Snapshot{ version, json } ) );
+    changes->add( *snapshots.back() );
+    return *snapshots.back();
+  }
+
+  It( sends_only_the_changed_entries_since_a_known_version )
+  {
+    add( 1, "{ \"objects\": { \"1\": { \"x\": 1 }, \"2\": { \"x\": 2 } }, \"clock\": 10 }" );
+    const auto& current( add( 2, "{ \"objects\": { \"1\": { \"x\": 1 }, \"2\": { \"x\": 3 } }, \"clock\": 11 }" ) );
+    AssertThat( changes->since( 1, current ), Equals(
+          "{\"version\":2,\"full\":false,\"changed\":{\"objects.2\":{ \"x\": 3 },\"clock\":11},\"removed\":[]}" ) );
+  }
+
+  It( lists_the_removed_entries )
+  {
+    add( 1, "{ \"objects\": { \"1\": {}, \"2\": {} } }" );
+    const auto& current( add( 2, "{ \"objects\": { \"1\": {} } }" ) );
+    AssertThat( changes->since( 1, current ), Equals(
+          "{\"version\":2,\"full\":false,\"changed\":{},\"removed\":[\"objects.2\"]}" ) );
+  }
+
+  It( sends_every_entry_for_a_forgotten_version )
+  {
+    add( 1, "{ \"clock\": 1 }" );
+    add( 2, "{ \"clock\": 2 }" );
+    const auto& current( add( 3, "{ \"clock\": 3 }" ) );
+    AssertThat( changes->since( 1, current ), Equals(
+          "{\"version\":3,\"full\":true,\"changed\":{\"clock\":3},\"removed\":[]}" ) );
+  }
+
+  It( sends_nothing_for_the_current_version )
+  {
+    const auto& current( add( 1, "{ \"objects\": { \"1\": {} } }" ) );
+    AssertThat( changes->since( 1, current ), Equals(
+          "{\"version\":1,\"full\":false,\"changed\":{},\"removed\":[]}" ) );
+  }
+
+  std::unique_ptr< yarrrs::ModelChanges > changes;
+  std::vector< std::unique_ptr< yarrrs::ModelSnapshot::Snapshot > > snapshots;
+};
+
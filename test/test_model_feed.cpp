@@ -0,0 +1,95 @@
+#include "../src/model_feed.hpp"
+
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( a_model_feed )
+{
+  void SetUp()
+  {
+    feed = std::make_unique< yarrrs::ModelFeed >();
+    sent.clear();
+  }
+
+  void publish( uint64_t version, const std::string& json )
+  {
+    snapshots.push_back( std::make_unique< yarrrs::ModelSnapshot::Snapshot >(
+          yarrrs::ModelSnapshot::Snapshot{ version, json } ) );
+    const yarrrs::ModelSnapshot::Snapshot& snapshot( *snapshots.back() );
+    sent.clear();
+    feed->publish( snapshot,
+        [ this, &snapshot ]( const std::string& path, const yarrrs::json::Slice* value )
+        {
+          sent.push_back( path + "=" +
+              ( value ? snapshot.json.substr( value->begin, value->end - value->begin ) : "" ) );
+        } );
+  }
+
+  It( has_no_subscribers_at_first )
+  {
+    AssertThat( feed->has_subscribers(), Equals( false ) );
+  }
+
+  It( sends_every_entry_of_a_new_topic )
+  {
+    feed->subscribe( "objects" );
+    publish( 1, "{ \"objects\": { \"1\": 1, \"2\": 2 }, \"clock\": 10 }" );
+    AssertThat( sent, Equals( std::vector< std::string >{ "objects.1=1", "objects.2=2" } ) );
+  }
+
+  It( sends_only_the_changed_entries_afterwards )
+  {
+    feed->subscribe( "objects" );
+    publish( 1, "{ \"objects\": { \"1\": 1, \"2\": 2 }, \"clock\": 10 }" );
+    publish( 2, "{ \"objects\": { \"1\": 1, \"2\": 3 }, \"clock\": 11 }" );
+    AssertThat( sent, Equals( std::vector< std::string >{ "objects.2=3" } ) );
+  }
+
+  It( sends_nothing_for_the_same_version_again )
+  {
+    feed->subscribe( "objects" );
+    publish( 1, "{ \"objects\": { \"1\": 1 } }" );
+    publish( 1, "{ \"objects\": { \"1\": 1 } }" );
+    AssertThat( sent, IsEmpty() );
+  }
+
+  It( sends_removed_entries_without_a_value )
+  {
+    feed->subscribe( "objects" );
+    publish( 1, "{ \"objects\": { \"1\": 1, \"2\": 2 } }" );
+    publish( 2, "{ \"objects\": { \"1\": 1 } }" );
+    AssertThat( sent, Equals( std::vector< std::string >{ "objects.2=" } ) );
+  }
+
+  It( sends_the_entries_of_a_topic_subscribed_later_in_full )
+  {
+    feed->subscribe( "objects" );
+    publish( 1, "{ \"objects\": { \"1\": 1 }, \"clock\": 10 }" );
+    feed->subscribe( "clock" );
+    publish( 1, "{ \"objects\": { \"1\": 1 }, \"clock\": 10 }" );
+    AssertThat( sent, Equals( std::vector< std::string >{ "clock=10" } ) );
+  }
+
+  It( sends_topics_deeper_than_an_entry_with_their_own_value )
+  {
+    feed->subscribe( "objects.1.x" );
+    publish( 1, "{ \"objects\": { \"1\": { \"x\": 5, \"y\": 6 } } }" );
+    AssertThat( sent, Equals( std::vector< std::string >{ "objects.1.x=5" } ) );
+  }
+
+  It( stops_sending_unsubscribed_topics )
+  {
+    feed->subscribe( "objects" );
+    publish( 1, "{ \"objects\": { \"1\": 1 } }" );
+    feed->unsubscribe( "objects" );
+    publish( 2, "{ \"objects\": { \"1\": 2 } }" );
+    AssertThat( sent, IsEmpty() );
+    AssertThat( feed->has_subscribers(), Equals( false ) );
+  }
+
+  std::unique_ptr< yarrrs::ModelFeed > feed;
+  std::vector< std::string > sent;
+  std::vector< std::unique_ptr< yarrrs::ModelSnapshot::Snapshot > > snapshots;
+};
+
@@ -0,0 +1,121 @@
+#include "../src/model_snapshot.hpp"
+#include "test_services.hpp"
+
+#include <igloo/igloo_alt.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace igloo;
+
+Describe( a_model_snapshot )
+{
+  void SetUp()
+  {
+    services = std::make_unique< test::Services >();
+    exports = 0;
+    snapshot = create_snapshot( std::chrono::hours( 1 ) );
+  }
+
+  void TearDown()
+  {
+    snapshot.reset();
+    services.reset();
+  }
+
+  std::unique_ptr< yarrrs::ModelSnapshot > create_snapshot( yarrrs::ModelSnapshot::Clock::duration max_age )
+  {
+    return std::make_unique< yarrrs::ModelSnapshot >(
+        [ this ]() { return "model " + std::to_string( ++exports ); },
+        max_age );
+  }
+
+  yarrrs::ModelSnapshot::Pointer read_while_publishing()
+  {
+    return read_while_publishing( [ this ]() { return snapshot->get( std::chrono::seconds( 10 ) ); } );
+  }
+
+  yarrrs::ModelSnapshot::Pointer read_while_publishing( std::function< yarrrs::ModelSnapshot::Pointer() > get )
+  {
+    std::atomic< bool > is_read( false );
+    yarrrs::ModelSnapshot::Pointer read;
+    std::thread reader(
+        [ &get, &is_read, &read ]()
+        {
+          read = get();
+          is_read = true;
+        } );
+
+    while ( !is_read )
+    {
+      snapshot->publish_if_requested();
+      std::this_thread::yield();
+    }
+
+    reader.join();
+    return read;
+  }
+
+  It( exports_nothing_while_nobody_asks )
+  {
+    snapshot->publish_if_requested();
+    AssertThat( exports, Equals( 0 ) );
+  }
+
+  It( hands_readers_the_snapshot_published_by_the_main_thread )
+  {
+    AssertThat( read_while_publishing()->json, Equals( "model 1" ) );
+  }
+
+  It( shares_a_fresh_snapshot_between_readers )
+  {
+    read_while_publishing();
+    AssertThat( snapshot->get( std::chrono::seconds( 0 ) )->json, Equals( "model 1" ) );
+    snapshot->publish_if_requested();
+    AssertThat( exports, Equals( 1 ) );
+  }
+
+  It( exports_again_when_the_snapshot_is_too_old )
+  {
+    snapshot = create_snapshot( std::chrono::seconds( 0 ) );
+    read_while_publishing();
+    const yarrrs::ModelSnapshot::Pointer second( read_while_publishing() );
+    AssertThat( second->json, Equals( "model 2" ) );
+    AssertThat( second->version, Equals( 2u ) );
+  }
+
+  It( exports_again_for_a_reader_asking_for_a_snapshot_taken_since_a_change )
+  {
+    read_while_publishing();
+    const yarrrs::ModelSnapshot::Clock::time_point changed( yarrrs::ModelSnapshot::Clock::now() );
+    const yarrrs::ModelSnapshot::Pointer second( read_while_publishing(
+          [ this, changed ]() { return snapshot->get_taken_since( changed, std::chrono::seconds( 10 ) ); } ) );
+    AssertThat( second->json, Equals( "model 2" ) );
+  }
+
+  It( returns_nothing_when_no_snapshot_is_published_in_time )
+  {
+    AssertThat( snapshot->get( std::chrono::milliseconds( 1 ) ) == nullptr, Equals( true ) );
+  }
+
+  It( wakes_the_waiting_readers_when_stopped )
+  {
+    yarrrs::ModelSnapshot::Pointer read( std::make_shared< const yarrrs::ModelSnapshot::Snapshot >() );
+    std::thread reader( [ this, &read ]() { read = snapshot->get( std::chrono::seconds( 10 ) ); } );
+    snapshot->stop();
+    reader.join();
+
+    AssertThat( read == nullptr, Equals( true ) );
+  }
+
+  It( counts_the_exports_in_the_metrics )
+  {
+    read_while_publishing();
+    AssertThat( services->metrics.export_text(), Contains( "yarrr_model_snapshots_total 1" ) );
+  }
+
+  std::unique_ptr< test::Services > services;
+  std::unique_ptr< yarrrs::ModelSnapshot > snapshot;
+  int exports;
+};
+
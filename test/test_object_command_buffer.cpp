@@ -0,0 +1,118 @@
+#include "../src/object_command_buffer.hpp"
+
+#include <yarrr/object.hpp>
+#include <yarrr/object_container.hpp>
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( an_object_command_buffer )
+{
+  void SetUp()
+  {
+    objects = std::make_unique< yarrr::ObjectContainer >();
+    buffer = std::make_unique< yarrrs::ObjectCommandBuffer >();
+    deleted_ids.clear();
+    number_of_reports = 0;
+  }
+
+  void apply()
+  {
+    buffer->apply_to( *objects,
+        [ this ]( const yarrrs::ObjectCommandBuffer::DeletedIds& ids )
+        {
+          deleted_ids.insert( std::end( deleted_ids ), std::begin( ids ), std::end( ids ) );
+          ++number_of_reports;
+        } );
+  }
+
+  yarrr::Object::Id add_object_to_container()
+  {
+    yarrr::Object::Pointer object( new yarrr::Object() );
+    const yarrr::Object::Id id( object->id() );
+    objects->add_object( std::move( object ) );
+    return id;
+  }
+
+  It ( is_empty_by_default )
+  {
+    AssertThat( buffer->empty(), Equals( true ) );
+  }
+
+  It ( adds_objects_only_when_applied )
+  {
+    yarrr::Object::Pointer object( new yarrr::Object() );
+    const yarrr::Object::Id id( object->id() );
+    buffer->add( std::move( object ) );
+    AssertThat( objects->has_object_with_id( id ), Equals( false ) );
+
+    apply();
+    AssertThat( objects->has_object_with_id( id ), Equals( true ) );
+  }
+
+  It ( deletes_objects_only_when_applied )
+  {
+    const yarrr::Object::Id id( add_object_to_container() );
+    buffer->remove( id );
+    AssertThat( objects->has_object_with_id( id ), Equals( true ) );
+
+    apply();
+    AssertThat( objects->has_object_with_id( id ), Equals( false ) );
+    AssertThat( deleted_ids, Equals( std::vector< yarrr::Object::Id >{ id } ) );
+  }
+
+  It ( deletes_and_reports_an_object_deleted_more_times_only_once )
+  {
+    const yarrr::Object::Id id( add_object_to_container() );
+    buffer->remove( id );
+    buffer->remove( id );
+    buffer->remove( id );
+
+    apply();
+    AssertThat( deleted_ids, HasLength( 1 ) );
+  }
+
+  It ( reports_the_deletions_of_a_batch_together )
+  {
+    buffer->remove( add_object_to_container() );
+    buffer->remove( add_object_to_container() );
+
+    apply();
+    AssertThat( deleted_ids, HasLength( 2 ) );
+    AssertThat( number_of_reports, Equals( 1 ) );
+  }
+
+  It ( reports_nothing_without_deletions )
+  {
+    buffer->add( yarrr::Object::Pointer( new yarrr::Object() ) );
+
+    apply();
+    AssertThat( number_of_reports, Equals( 0 ) );
+  }
+
+  It ( can_delete_an_object_added_in_the_same_batch )
+  {
+    yarrr::Object::Pointer object( new yarrr::Object() );
+    const yarrr::Object::Id id( object->id() );
+    buffer->add( std::move( object ) );
+    buffer->remove( id );
+
+    apply();
+    AssertThat( objects->has_object_with_id( id ), Equals( false ) );
+  }
+
+  It ( is_empty_after_applied )
+  {
+    buffer->add( yarrr::Object::Pointer( new yarrr::Object() ) );
+    buffer->remove( add_object_to_container() );
+
+    apply();
+    AssertThat( buffer->empty(), Equals( true ) );
+  }
+
+  std::unique_ptr< yarrr::ObjectContainer > objects;
+  std::unique_ptr< yarrrs::ObjectCommandBuffer > buffer;
+  std::vector< yarrr::Object::Id > deleted_ids;
+  int number_of_reports;
+};
+
@@ -0,0 +1,146 @@
+#include "../src/object_updates.hpp"
+#include "../src/worker_pool.hpp"
+#include "../src/zones.hpp"
+#include "test_services.hpp"
+
+#include <yarrr/object.hpp>
+#include <yarrr/object_container.hpp>
+#include <yarrr/basic_behaviors.hpp>
+#include <yarrr/delete_object.hpp>
+#include <igloo/igloo_alt.h>
+
+#include <algorithm>
+
+using namespace igloo;
+
+Describe( sending_object_updates )
+{
+  test::Services::PlayerBundle::Pointer log_in( const std::string& name )
+  {
+    auto bundle( services->create_player( name ) );
+    services->players[ bundle->connection.connection->id ] = bundle->take_player_ownership();
+    return bundle;
+  }
+
+  yarrr::Object::Id place_ship_of( yarrrs::Player& player, yarrr::Coordinate::type x )
+  {
+    yarrr::Object::Pointer ship( new yarrr::Object() );
+    ship->add_behavior( std::make_unique< yarrr::PhysicalBehavior >() );
+    yarrr::component_of< yarrr::PhysicalBehavior >( *ship ).physical_parameters.coordinate.x = x;
+    const yarrr::Object::Id id( ship->id() );
+    player.assign_object( *ship );
+    services->objects.add_object( std::move( ship ) );
+    return id;
+  }
+
+  void SetUp()
+  {
+    services = std::make_unique< test::Services >();
+    near_player = log_in( "Kilgore Trout" );
+    far_player = log_in( "Rabo Karabekian" );
+    near_ship_id = place_ship_of( near_player->player, 0 );
+    far_ship_id = place_ship_of( far_player->player, 1000000 );
+    near_player->connection.flush_connection();
+    far_player->connection.flush_connection();
+  }
+
+  void TearDown()
+  {
+    near_player.reset();
+    far_player.reset();
+    services.reset();
+  }
+
+  std::vector< yarrr::Object::Id > updates_received_by( test::Services::PlayerBundle& bundle )
+  {
+    std::vector< yarrr::Object::Id > ids;
+    for ( const auto& update : bundle.connection.entities< yarrr::ObjectUpdate >() )
+    {
+      ids.push_back( update->id() );
+    }
+
+    return ids;
+  }
+
+  bool has_update_of( const std::vector< yarrr::Object::Id >& ids, yarrr::Object::Id id )
+  {
+    return std::find( std::begin( ids ), std::end( ids ), id ) != std::end( ids );
+  }
+
+  int64_t tick_when_far_ship_is_not_due() const
+  {
+    return int64_t( ( far_ship_id + 1 ) % interval );
+  }
+
+  It( sends_every_update_to_every_player_by_default )
+  {
+    yarrrs::send_object_updates( services->objects, services->players, priorities, compact_physics );
+    const auto ids( updates_received_by( *near_player ) );
+    AssertThat( has_update_of( ids, near_ship_id ), Equals( true ) );
+    AssertThat( has_update_of( ids, far_ship_id ), Equals( true ) );
+  }
+
+  It( skips_distant_objects_when_they_are_not_due )
+  {
+    yarrrs::send_object_updates( services->objects, services->players, priorities, compact_physics,
+        yarrrs::DistantUpdates{ radius, interval, tick_when_far_ship_is_not_due() } );
+    const auto ids( updates_received_by( *near_player ) );
+    AssertThat( has_update_of( ids, near_ship_id ), Equals( true ) );
+    AssertThat( has_update_of( ids, far_ship_id ), Equals( false ) );
+  }
+
+  It( always_sends_the_own_ship_of_the_player )
+  {
+    yarrrs::send_object_updates( services->objects, services->players, priorities, compact_physics,
+        yarrrs::DistantUpdates{ radius, interval, tick_when_far_ship_is_not_due() } );
+    AssertThat( has_update_of( updates_received_by( *far_player ), far_ship_id ), Equals( true ) );
+  }
+
+  It( sends_distant_objects_when_they_are_due )
+  {
+    yarrrs::send_object_updates( services->objects, services->players, priorities, compact_physics,
+        yarrrs::DistantUpdates{ radius, interval, tick_when_far_ship_is_not_due() + 1 } );
+    AssertThat( has_update_of( updates_received_by( *near_player ), far_ship_id ), Equals( true ) );
+  }
+
+  It( sends_the_own_ship_of_the_player_first )
+  {
+    yarrrs::send_object_updates( services->objects, services->players, priorities, compact_physics );
+    AssertThat( updates_received_by( *near_player ).front(), Equals( near_ship_id ) );
+    AssertThat( updates_received_by( *far_player ).front(), Equals( far_ship_id ) );
+  }
+
+  It( sends_only_the_objects_of_the_neighboring_zones_with_zones )
+  {
+    yarrrs::WorkerPool workers( 1 );
+    yarrrs::Zones zones( radius, workers );
+    yarrrs::send_object_updates( services->objects, services->players, priorities, compact_physics,
+        yarrrs::DistantUpdates{ 0, 1, 0 }, &zones );
+    const auto ids( updates_received_by( *near_player ) );
+    AssertThat( has_update_of( ids, near_ship_id ), Equals( true ) );
+    AssertThat( has_update_of( ids, far_ship_id ), Equals( false ) );
+  }
+
+  It( deletes_objects_leaving_the_neighboring_zones_on_the_client )
+  {
+    yarrrs::send_object_updates( services->objects, services->players, priorities, compact_physics );
+    near_player->connection.flush_connection();
+
+    yarrrs::WorkerPool workers( 1 );
+    yarrrs::Zones zones( radius, workers );
+    yarrrs::send_object_updates( services->objects, services->players, priorities, compact_physics,
+        yarrrs::DistantUpdates{ 0, 1, 0 }, &zones );
+    AssertThat( near_player->connection.entities< yarrr::DeleteObject >(), HasLength( 1 ) );
+  }
+
+  const int64_t radius{ 1000 };
+  const int interval{ 2 };
+  const yarrrs::UpdatePriorities priorities{ yarrrs::UpdatePriorities::from_configuration() };
+  const yarrrs::CompactPhysics compact_physics{ yarrrs::CompactPhysics::Quantization::from_configuration() };
+  std::unique_ptr< test::Services > services;
+  test::Services::PlayerBundle::Pointer near_player;
+  test::Services::PlayerBundle::Pointer far_player;
+  yarrr::Object::Id near_ship_id;
+  yarrr::Object::Id far_ship_id;
+};
+
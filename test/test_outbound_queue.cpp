@@ -0,0 +1,225 @@
+#include "../src/outbound_queue.hpp"
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( an_outbound_queue )
+{
+  yarrr::Data update_of_size( size_t size, char content = 'a' )
+  {
+    return yarrr::Data( size, content );
+  }
+
+  std::unique_ptr< yarrrs::OutboundQueue > create_queue( yarrrs::OutboundQueue::Policy policy )
+  {
+    return std::make_unique< yarrrs::OutboundQueue >( yarrrs::OutboundQueue::Limits{
+        bytes_per_tick,
+        queue_limit,
+        policy,
+        grace_ticks } );
+  }
+
+  bool flush( size_t bytes_sent_around = 0 )
+  {
+    return queue->flush(
+        [ this ]( yarrr::Data&& update )
+        {
+          if ( !is_accepting )
+          {
+            return false;
+          }
+
+          sent_updates.emplace_back( std::move( update ) );
+          return true;
+        },
+        bytes_sent_around );
+  }
+
+  void SetUp()
+  {
+    sent_updates.clear();
+    is_accepting = true;
+    queue = create_queue( yarrrs::OutboundQueue::drop_stale );
+  }
+
+  It ( sends_queued_updates_when_flushed )
+  {
+    queue->push( 1, update_of_size( 10 ) );
+    queue->push( 2, update_of_size( 10 ) );
+    AssertThat( queue->queued_bytes(), Equals( 20u ) );
+
+    AssertThat( flush(), Equals( true ) );
+    AssertThat( sent_updates, HasLength( 2 ) );
+    AssertThat( queue->queued_bytes(), Equals( 0u ) );
+  }
+
+  It ( keeps_only_the_latest_update_of_an_object )
+  {
+    queue->push( 1, update_of_size( 10, 'a' ) );
+    queue->push( 1, update_of_size( 12, 'b' ) );
+    AssertThat( queue->queued_bytes(), Equals( 12u ) );
+    AssertThat( queue->dropped_bytes(), Equals( 10u ) );
+
+    flush();
+    AssertThat( sent_updates, HasLength( 1 ) );
+    AssertThat( sent_updates.back(), Equals( update_of_size( 12, 'b' ) ) );
+  }
+
+  It ( carries_updates_over_the_byte_budget_to_the_next_tick )
+  {
+    queue->push( 1, update_of_size( 60 ) );
+    queue->push( 2, update_of_size( 60 ) );
+    flush();
+    AssertThat( sent_updates, HasLength( 1 ) );
+    AssertThat( queue->queued_bytes(), Equals( 60u ) );
+
+    flush();
+    AssertThat( sent_updates, HasLength( 2 ) );
+  }
+
+  It ( sends_the_updates_with_the_highest_priority_first )
+  {
+    queue->push( 1, update_of_size( 60, 'a' ), 1.0 );
+    queue->push( 2, update_of_size( 60, 'b' ), 5.0 );
+    flush();
+    AssertThat( sent_updates, HasLength( 1 ) );
+    AssertThat( sent_updates.back(), Equals( update_of_size( 60, 'b' ) ) );
+  }
+
+  It ( accumulates_the_priority_of_updates_carried_over )
+  {
+    queue->push( 1, update_of_size( 60, 'a' ), 1.0 );
+    queue->push( 2, update_of_size( 60, 'b' ), 1.5 );
+    flush();
+
+    queue->push( 1, update_of_size( 60, 'c' ), 1.0 );
+    queue->push( 2, update_of_size( 60, 'd' ), 1.5 );
+    flush();
+    AssertThat( sent_updates.back(), Equals( update_of_size( 60, 'c' ) ) );
+  }
+
+  It ( does_not_send_removed_updates )
+  {
+    queue->push( 1, update_of_size( 10, 'a' ) );
+    queue->push( 2, update_of_size( 12, 'b' ) );
+    queue->remove( { 1, 3 } );
+    AssertThat( queue->queued_bytes(), Equals( 12u ) );
+    AssertThat( queue->is_queued( 1 ), Equals( false ) );
+
+    flush();
+    AssertThat( sent_updates, HasLength( 1 ) );
+    AssertThat( sent_updates.back(), Equals( update_of_size( 12, 'b' ) ) );
+  }
+
+  It ( sends_an_update_bigger_than_the_budget_on_its_own )
+  {
+    queue->push( 1, update_of_size( bytes_per_tick * 2 ) );
+    flush();
+    AssertThat( sent_updates, HasLength( 1 ) );
+  }
+
+  It ( counts_the_bytes_sent_around_the_queue_against_the_budget )
+  {
+    queue->push( 1, update_of_size( 30 ) );
+    queue->push( 2, update_of_size( 60 ) );
+    flush( 50 );
+    AssertThat( sent_updates, HasLength( 1 ) );
+    AssertThat( sent_updates.back(), HasLength( 30 ) );
+  }
+
+  It ( stops_sending_when_the_connection_refuses_an_update )
+  {
+    queue = create_queue( yarrrs::OutboundQueue::degrade );
+    queue->push( 1, update_of_size( 10 ) );
+    queue->push( 2, update_of_size( 12 ) );
+    is_accepting = false;
+    flush();
+    AssertThat( queue->dropped_bytes(), Equals( 10u ) );
+    AssertThat( queue->is_queued( 2 ), Equals( true ) );
+  }
+
+  It ( treats_a_refused_send_as_a_slow_client )
+  {
+    queue = create_queue( yarrrs::OutboundQueue::disconnect );
+    is_accepting = false;
+    for ( int i( 0 ); i < grace_ticks; ++i )
+    {
+      queue->push( 1, update_of_size( 10 ) );
+      AssertThat( flush(), Equals( true ) );
+    }
+
+    queue->push( 1, update_of_size( 10 ) );
+    AssertThat( flush(), Equals( false ) );
+  }
+
+  It ( drops_the_backlog_above_the_queue_limit_with_drop_stale_policy )
+  {
+    for ( yarrr::Object::Id id( 0 ); id < 10; ++id )
+    {
+      queue->push( id, update_of_size( 60 ) );
+    }
+
+    AssertThat( flush(), Equals( true ) );
+    AssertThat( sent_updates, HasLength( 1 ) );
+    AssertThat( queue->queued_bytes(), Equals( 0u ) );
+  }
+
+  It ( lowers_the_update_rate_with_degrade_policy )
+  {
+    queue = create_queue( yarrrs::OutboundQueue::degrade );
+    for ( yarrr::Object::Id id( 0 ); id < 10; ++id )
+    {
+      queue->push( id, update_of_size( 60 ) );
+    }
+
+    AssertThat( flush(), Equals( true ) );
+    AssertThat( queue->update_interval(), Equals( 2 ) );
+
+    sent_updates.clear();
+    flush();
+    AssertThat( sent_updates, IsEmpty() );
+    flush();
+    AssertThat( sent_updates, HasLength( 1 ) );
+  }
+
+  It ( restores_the_update_rate_when_the_client_catches_up )
+  {
+    queue = create_queue( yarrrs::OutboundQueue::degrade );
+    for ( yarrr::Object::Id id( 0 ); id < 4; ++id )
+    {
+      queue->push( id, update_of_size( 60 ) );
+    }
+
+    flush();
+    AssertThat( queue->update_interval(), Equals( 2 ) );
+    flush();
+    flush();
+    AssertThat( queue->update_interval(), Equals( 1 ) );
+  }
+
+  It ( asks_for_disconnection_after_the_grace_period_with_disconnect_policy )
+  {
+    queue = create_queue( yarrrs::OutboundQueue::disconnect );
+    for ( yarrr::Object::Id id( 0 ); id < 10; ++id )
+    {
+      queue->push( id, update_of_size( 60 ) );
+    }
+
+    for ( int i( 0 ); i < grace_ticks; ++i )
+    {
+      queue->push( 100 + i, update_of_size( 60 ) );
+      AssertThat( flush(), Equals( true ) );
+    }
+
+    AssertThat( flush(), Equals( false ) );
+  }
+
+  const size_t bytes_per_tick{ 100 };
+  const size_t queue_limit{ 150 };
+  const int grace_ticks{ 3 };
+
+  std::unique_ptr< yarrrs::OutboundQueue > queue;
+  std::vector< yarrr::Data > sent_updates;
+  bool is_accepting;
+};
+
@@ -0,0 +1,82 @@
+#include "../src/overload_controller.hpp"
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( an_overload_controller )
+{
+  void SetUp()
+  {
+    controller = std::make_unique< yarrrs::OverloadController >( limits );
+  }
+
+  void record( int ticks, int milliseconds )
+  {
+    for ( int i( 0 ); i < ticks; ++i )
+    {
+      controller->record( std::chrono::milliseconds( milliseconds ) );
+    }
+  }
+
+  It( starts_in_the_normal_stage )
+  {
+    AssertThat( controller->stage(), Equals( yarrrs::OverloadController::normal ) );
+  }
+
+  It( stays_in_the_normal_stage_after_a_single_heavy_tick )
+  {
+    record( 1, 150 );
+    record( 1, 10 );
+    record( heavy_ticks_to_raise - 1, 150 );
+    AssertThat( controller->stage(), Equals( yarrrs::OverloadController::normal ) );
+  }
+
+  It( throttles_distant_updates_after_consecutive_heavy_ticks )
+  {
+    record( heavy_ticks_to_raise, 95 );
+    AssertThat( controller->stage(), Equals( yarrrs::OverloadController::distant_updates_throttled ) );
+  }
+
+  It( raises_the_stage_step_by_step_up_to_pausing_logins )
+  {
+    record( heavy_ticks_to_raise * 2, 150 );
+    AssertThat( controller->stage(), Equals( yarrrs::OverloadController::background_work_deferred ) );
+
+    record( heavy_ticks_to_raise * 5, 150 );
+    AssertThat( controller->stage(), Equals( yarrrs::OverloadController::logins_paused ) );
+    AssertThat( controller->is_at_least( yarrrs::OverloadController::distant_updates_throttled ), Equals( true ) );
+  }
+
+  It( keeps_the_stage_while_the_load_is_between_the_ratios )
+  {
+    record( heavy_ticks_to_raise, 150 );
+    record( light_ticks_to_lower * 2, 80 );
+    AssertThat( controller->stage(), Equals( yarrrs::OverloadController::distant_updates_throttled ) );
+  }
+
+  It( lowers_the_stage_after_enough_light_ticks )
+  {
+    record( heavy_ticks_to_raise * 2, 150 );
+    record( light_ticks_to_lower - 1, 10 );
+    AssertThat( controller->stage(), Equals( yarrrs::OverloadController::background_work_deferred ) );
+
+    record( 1, 10 );
+    AssertThat( controller->stage(), Equals( yarrrs::OverloadController::distant_updates_throttled ) );
+
+    record( light_ticks_to_lower, 10 );
+    AssertThat( controller->stage(), Equals( yarrrs::OverloadController::normal ) );
+  }
+
+  It( has_a_name_for_every_stage )
+  {
+    AssertThat( std::string( yarrrs::OverloadController::name_of( yarrrs::OverloadController::logins_paused ) ),
+        Equals( "logins_paused" ) );
+  }
+
+  const int heavy_ticks_to_raise{ 3 };
+  const int light_ticks_to_lower{ 10 };
+  const yarrrs::OverloadController::Limits limits{
+    std::chrono::milliseconds( 100 ), 0.9, 0.6, heavy_ticks_to_raise, light_ticks_to_lower };
+  std::unique_ptr< yarrrs::OverloadController > controller;
+};
+
@@ -5,6 +5,7 @@
 #include <yarrr/object_container.hpp>
 #include <yarrr/chat_message.hpp>
 #include <yarrr/command.hpp>
+#include <yarrr/delete_object.hpp>
 #include <yarrr/mission.hpp>
 #include <yarrr/mission_exporter.hpp>
 #include <igloo/igloo_alt.h>
@@ -63,6 +64,7 @@ Describe( a_player )
     AssertThat( services->modell_container.exists( category, id ), Equals( true ) );
     auto& model( services->modell_container.create_with_id_if_needed( category, id ) );
     model[ "a_new_key"] = "a new value";
+    player->player.flush_model_changes();
     assert_nth_model_synchronized_with_id( 0, category, id );
   }
 
@@ -95,7 +97,7 @@ Describe( a_player )
 
   void set_up_command_handler()
   {
-    command_result = std::make_tuple( true, "success" );
+    command_result = yarrrs::CommandHandler::Result::success();
     dispatched_player = nullptr;
     dispatched_command = nullptr;
     services->command_handler.register_handler( command_name,
@@ -166,9 +168,82 @@ Describe( a_player )
   It ( broadcasts_chat_messages )
   {
     player->connection.wrapper.dispatch( yarrr::ChatMessage( "", "" ) );
+    services->world->tick();
     AssertThat( another_player->connection.has_no_data(), Equals( false ) );
   }
 
+  It ( broadcasts_serialized_messages_to_every_player )
+  {
+    auto third_player( services->create_player( "Rabo Karabekian" ) );
+    services->players[ third_player->connection.connection->id ] = third_player->take_player_ownership();
+    another_player->connection.flush_connection();
+    third_player->connection.flush_connection();
+
+    yarrrs::broadcast( services->players, yarrr::ChatMessage( "a message", "server" ).serialize() );
+    AssertThat( another_player->connection.get_entity< yarrr::ChatMessage >()->message(), Equals( "a message" ) );
+    AssertThat( third_player->connection.get_entity< yarrr::ChatMessage >()->message(), Equals( "a message" ) );
+  }
+
+  It ( counts_the_bytes_sent )
+  {
+    const size_t sent_bytes_before( player->player.sent_bytes() );
+    yarrr::Data message( yarrr::ChatMessage( "a message", "server" ).serialize() );
+    const size_t message_size( message.size() );
+    player->player.send( std::move( message ) );
+    AssertThat( player->player.sent_bytes(), Equals( sent_bytes_before + message_size ) );
+  }
+
+  It ( counts_model_traffic_in_the_metrics )
+  {
+    yarrrs::Metrics::Value& model_bytes( services->metrics.counter(
+          "yarrr_sent_bytes_total", "", yarrrs::Metrics::label( "type", "model" ) ) );
+    const double model_bytes_before( model_bytes.get() );
+    auto& player_model( services->modell_container.create_with_id_if_needed( "player", player_name ) );
+    player_model[ "a_new_key"] = "a new value";
+    player->player.flush_model_changes();
+    AssertThat( model_bytes.get() > model_bytes_before, Equals( true ) );
+  }
+
+  It ( sends_deleted_objects_one_by_one_to_players_without_the_delete_list_capability )
+  {
+    another_player->player.queue_object_update( 11, yarrr::Data( 8, 'a' ) );
+    another_player->player.queue_object_update( 12, yarrr::Data( 8, 'a' ) );
+    another_player->connection.flush_connection();
+    yarrrs::broadcast_deleted_objects( services->players, { 11, 12 } );
+    AssertThat( another_player->connection.entities< yarrr::DeleteObject >(), HasLength( 2 ) );
+  }
+
+  It ( sends_deleted_objects_only_to_players_who_were_shown_them )
+  {
+    another_player->player.queue_object_update( 11, yarrr::Data( 8, 'a' ) );
+    another_player->connection.flush_connection();
+    player->connection.flush_connection();
+    yarrrs::broadcast_deleted_objects( services->players, { 11, 12 } );
+    AssertThat( another_player->connection.entities< yarrr::DeleteObject >(), HasLength( 1 ) );
+    AssertThat( player->connection.has_entity< yarrr::DeleteObject >(), Equals( false ) );
+  }
+
+  It ( sends_deleted_objects_in_one_command_to_players_with_the_delete_list_capability )
+  {
+    test::Connection connection;
+    yarrrs::Player::Container players;
+    players[ connection.connection->id ] = std::make_unique< yarrrs::Player >(
+        players,
+        "Rabo Karabekian",
+        connection.wrapper,
+        services->command_handler,
+        yarrrs::Capabilities{ yarrrs::Capabilities::delete_list } );
+    players.begin()->second->queue_object_update( 11, yarrr::Data( 8, 'a' ) );
+    players.begin()->second->queue_object_update( 12, yarrr::Data( 8, 'a' ) );
+    connection.flush_connection();
+
+    yarrrs::broadcast_deleted_objects( players, { 11, 12 } );
+    AssertThat( connection.has_entity< yarrr::DeleteObject >(), Equals( false ) );
+    auto command( connection.get_entity< yarrr::Command >() );
+    AssertThat( command->command(), Equals( yarrrs::Capabilities::delete_list ) );
+    AssertThat( command->parameters(), Equals( std::vector< std::string >{ "11", "12" } ) );
+  }
+
   It ( sends_object_assigned_to_the_player )
   {
     AssertThat( player->player.object_id(), Equals( ship->id() ) );
@@ -266,9 +341,22 @@ Describe( a_player )
     player->connection.flush_connection();
     auto& player_model( services->modell_container.create_with_id_if_needed( "player", player_name ) );
     player_model[ "a_new_key"] = "a new value";
+    player->player.flush_model_changes();
     assert_nth_model_synchronized_with_id( 0, "player", player_name );
   }
 
+  It ( sends_a_changed_model_only_once_in_a_tick )
+  {
+    player->connection.flush_connection();
+    auto& player_model( services->modell_container.create_with_id_if_needed( "player", player_name ) );
+    player_model[ "a_new_key"] = "a new value";
+    player_model[ "another_new_key"] = "another new value";
+    AssertThat( player->connection.entities< yarrr::ModellSerializer >(), IsEmpty() );
+
+    player->player.flush_model_changes();
+    AssertThat( player->connection.entities< yarrr::ModellSerializer >(), HasLength( 1 ) );
+  }
+
   It ( resends_character_model_if_it_changes )
   {
     assert_resends_model_if_it_changes( "character", assigned_model_id( player_model(), "character" ) );
@@ -299,6 +387,14 @@ Describe( a_player )
     AssertThat( player->connection.get_entity< yarrr::Mission >()->id(), Equals( mission_id ) );
   }
 
+  It( does_not_resend_unchanged_missions )
+  {
+    player->player.update_missions();
+    player->connection.flush_connection();
+    player->player.update_missions();
+    AssertThat( player->connection.has_entity< yarrr::Mission >(), Equals( false ) );
+  }
+
   It( sends_out_the_finished_state_of_the_mission )
   {
     player->connection.flush_connection();
@@ -327,6 +423,26 @@ Describe( a_player )
     AssertThat( permanent_object.get( yarrr::model::realtime_object_id ), Equals( std::to_string( new_ship.id() ) ) );
   }
 
+  It( exports_its_queued_bytes_until_it_is_gone )
+  {
+    const std::string labels( yarrrs::Metrics::label( "player", player_name ) );
+    AssertThat( services->metrics.export_text(), Contains( "yarrr_player_queued_bytes{" + labels ) );
+
+    player.reset();
+    AssertThat( services->metrics.export_text().find( "yarrr_player_queued_bytes{" + labels ), Equals( std::string::npos ) );
+  }
+
+  It( keeps_showing_an_updated_object_until_it_is_forgotten )
+  {
+    const yarrr::Object::Id id( 42 );
+    player->player.queue_object_update( id, yarrr::Data( 8, 'a' ) );
+    player->player.flush_object_updates();
+    AssertThat( player->player.is_showing_object( id ), Equals( true ) );
+
+    player->player.stop_showing_objects( { id } );
+    AssertThat( player->player.is_showing_object( id ), Equals( false ) );
+  }
+
   It ( executes_commands_with_the_command_handler )
   {
     player->connection.wrapper.dispatch( command );
@@ -344,7 +460,7 @@ Describe( a_player )
   It ( sends_a_chat_message_for_a_failed_command_containing_the_error_message )
   {
     const std::string the_error_message( "an error message" );
-    command_result = std::make_tuple( false, the_error_message );
+    command_result = yarrrs::CommandHandler::Result::failure( the_error_message );
     player->connection.flush_connection();
     player->connection.wrapper.dispatch( command );
     AssertThat( player->connection.get_entity< yarrr::ChatMessage >()->message(), Contains( "failed" ) );
@@ -358,7 +474,7 @@ Describe( a_player )
   const yarrr::Command command{ { command_name } };
   yarrrs::Player* dispatched_player{ nullptr };
   const yarrr::Command* dispatched_command{ nullptr };
-  yarrrs::CommandHandler::Result command_result;
+  yarrrs::CommandHandler::Result command_result{ yarrrs::CommandHandler::Result::success() };
 
   std::unique_ptr< test::Services::PlayerBundle > player;
   std::unique_ptr< test::Services::PlayerBundle > another_player;
@@ -0,0 +1,63 @@
+#include "../src/rate_limiter.hpp"
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( a_rate_limiter )
+{
+  void SetUp()
+  {
+    limiter = std::make_unique< yarrrs::RateLimiter >( burst, ticks_per_token );
+  }
+
+  void use_up_the_burst()
+  {
+    for ( int i( 0 ); i < burst; ++i )
+    {
+      limiter->try_acquire();
+    }
+  }
+
+  void tick( int ticks )
+  {
+    for ( int i( 0 ); i < ticks; ++i )
+    {
+      limiter->tick();
+    }
+  }
+
+  It ( allows_a_burst_of_requests )
+  {
+    for ( int i( 0 ); i < burst; ++i )
+    {
+      AssertThat( limiter->try_acquire(), Equals( true ) );
+    }
+  }
+
+  It ( rejects_requests_over_the_burst )
+  {
+    use_up_the_burst();
+    AssertThat( limiter->try_acquire(), Equals( false ) );
+  }
+
+  It ( gains_a_token_after_the_given_number_of_ticks )
+  {
+    use_up_the_burst();
+    tick( ticks_per_token - 1 );
+    AssertThat( limiter->try_acquire(), Equals( false ) );
+    tick( 1 );
+    AssertThat( limiter->try_acquire(), Equals( true ) );
+  }
+
+  It ( does_not_save_up_more_tokens_than_the_burst )
+  {
+    tick( ticks_per_token * burst * 2 );
+    use_up_the_burst();
+    AssertThat( limiter->try_acquire(), Equals( false ) );
+  }
+
+  const int burst{ 3 };
+  const int ticks_per_token{ 4 };
+  std::unique_ptr< yarrrs::RateLimiter > limiter;
+};
+
@@ -0,0 +1,105 @@
+#include "../src/redis_cluster_store.hpp"
+
+#include <igloo/igloo_alt.h>
+#include <lua.hpp>
+
+#include <memory>
+
+using namespace igloo;
+
+namespace
+{
+
+//stands in for the commands of redis the scripts call, keys never expire
+const std::string fake_redis(
+    "store = store or {} "
+    "redis = { call = function( command, key, value ) "
+    "  if command == 'get' then return store[ key ] or false end "
+    "  if command == 'set' then store[ key ] = value return 'OK' end "
+    "  if command == 'del' then "
+    "    local deleted = store[ key ] and 1 or 0 "
+    "    store[ key ] = nil "
+    "    return deleted "
+    "  end "
+    "end } " );
+
+}
+
+Describe( the_scripts_of_the_redis_cluster_store )
+{
+  void SetUp()
+  {
+    lua.reset( luaL_newstate() );
+    luaL_openlibs( lua.get() );
+  }
+
+  std::string run( const std::string& script, const std::string& key, const std::string& arguments = "" )
+  {
+    const std::string program(
+        fake_redis +
+        "KEYS = { '" + key + "' } "
+        "ARGV = { " + arguments + " } "
+        "return tostring( ( function() " + script + " end )() )" );
+    if ( luaL_dostring( lua.get(), program.c_str() ) )
+    {
+      return std::string( "error: " ) + lua_tostring( lua.get(), -1 );
+    }
+
+    const std::string result( lua_tostring( lua.get(), -1 ) );
+    lua_pop( lua.get(), 1 );
+    return result;
+  }
+
+  std::string acquire( const std::string& owner )
+  {
+    return run( yarrrs::RedisClusterStore::acquire_lease_script, key, "'" + owner + "', '3000'" );
+  }
+
+  std::string release( const std::string& owner )
+  {
+    return run( yarrrs::RedisClusterStore::release_lease_script, key, "'" + owner + "'" );
+  }
+
+  std::string stored()
+  {
+    return run( "return store[ KEYS[ 1 ] ]", key );
+  }
+
+  It( acquire_a_free_key )
+  {
+    AssertThat( acquire( "here" ), Equals( "1" ) );
+    AssertThat( stored(), Equals( "here" ) );
+  }
+
+  It( renew_a_key_of_the_same_owner )
+  {
+    acquire( "here" );
+    AssertThat( acquire( "here" ), Equals( "1" ) );
+  }
+
+  It( leave_a_key_of_another_owner_alone )
+  {
+    acquire( "there" );
+    AssertThat( acquire( "here" ), Equals( "0" ) );
+    AssertThat( release( "here" ), Equals( "0" ) );
+    AssertThat( stored(), Equals( "there" ) );
+  }
+
+  It( release_a_key_of_the_same_owner )
+  {
+    acquire( "here" );
+    AssertThat( release( "here" ), Equals( "1" ) );
+    AssertThat( stored(), Equals( "nil" ) );
+  }
+
+  It( take_a_value_only_once )
+  {
+    run( "store[ KEYS[ 1 ] ] = 'ship'", key );
+    AssertThat( run( yarrrs::RedisClusterStore::take_script, key ), Equals( "ship" ) );
+    AssertThat( run( yarrrs::RedisClusterStore::take_script, key ), Equals( "false" ) );
+  }
+
+  const std::string key{ "cluster:player:Kilgore Trout" };
+  std::unique_ptr< lua_State, void(*)( lua_State* ) > lua{ nullptr, lua_close };
+};
+
@@ -0,0 +1,53 @@
+#include "../src/remote_model_feed.hpp"
+#include "test_services.hpp"
+#include "test_zmq_client.hpp"
+
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( a_remote_model_feed )
+{
+  void SetUp()
+  {
+    services = std::make_unique< test::Services >();
+    snapshot = std::make_unique< yarrrs::ModelSnapshot >(
+        [ this ]() { return model; },
+        std::chrono::hours( 1 ) );
+    feed = std::make_unique< yarrrs::RemoteModelFeed >( endpoint, *snapshot, std::chrono::milliseconds( 0 ) );
+    subscriber = std::make_unique< test::ZmqClient >( ZMQ_SUB, endpoint );
+  }
+
+  void TearDown()
+  {
+    subscriber.reset();
+    feed.reset();
+    snapshot.reset();
+    services.reset();
+  }
+
+  std::vector< std::string > receive_after_subscribing_to( const std::string& topic )
+  {
+    zmq_setsockopt( subscriber->socket(), ZMQ_SUBSCRIBE, topic.data(), topic.size() );
+    return subscriber->receive( [ this ]() { snapshot->publish_if_requested(); } );
+  }
+
+  It( listens_on_its_endpoint )
+  {
+    AssertThat( feed->is_listening(), Equals( true ) );
+  }
+
+  It( sends_the_path_and_the_value_of_a_subscribed_entry )
+  {
+    AssertThat( receive_after_subscribing_to( "objects.12" ),
+        Equals( std::vector< std::string >{ "objects.12", "{ \"x\": 1 }" } ) );
+  }
+
+  const std::string endpoint{ "ipc:///tmp/yarrrs_test_remote_model_feed" };
+  const std::string model{ "{ \"objects\": { \"12\": { \"x\": 1 } }, \"clock\": 42 }" };
+  std::unique_ptr< test::Services > services;
+  std::unique_ptr< yarrrs::ModelSnapshot > snapshot;
+  std::unique_ptr< yarrrs::RemoteModelFeed > feed;
+  std::unique_ptr< test::ZmqClient > subscriber;
+};
+
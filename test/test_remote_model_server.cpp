@@ -0,0 +1,86 @@
+#include "../src/remote_model_server.hpp"
+#include "test_services.hpp"
+#include "test_zmq_client.hpp"
+
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( a_remote_model_server )
+{
+  void SetUp()
+  {
+    services = std::make_unique< test::Services >();
+    snapshot = std::make_unique< yarrrs::ModelSnapshot >(
+        [ this ]() { return model; },
+        std::chrono::hours( 1 ) );
+    server = std::make_unique< yarrrs::RemoteModelServer >( endpoint, *snapshot,
+        [ this ]( const std::string& code )
+        {
+          executed = code;
+          model = "{ \"executed\": true }";
+        } );
+    client = std::make_unique< test::ZmqClient >( ZMQ_REQ, endpoint );
+  }
+
+  void TearDown()
+  {
+    client.reset();
+    server.reset();
+    snapshot.reset();
+    services.reset();
+  }
+
+  std::string ask( const std::string& request )
+  {
+    client->send( request );
+    const std::vector< std::string > reply( client->receive(
+          [ this ]()
+          {
+            services->main_thread_callback_queue.process_callbacks();
+            snapshot->publish_if_requested();
+          } ) );
+    return reply.empty() ? "no reply" : reply.front();
+  }
+
+  It( listens_on_its_endpoint )
+  {
+    AssertThat( server->is_listening(), Equals( true ) );
+  }
+
+  It( answers_a_path_with_the_value_at_it )
+  {
+    AssertThat( ask( "objects.12" ), Equals( "{ \"x\": 1 }" ) );
+  }
+
+  It( answers_the_empty_path_with_the_whole_model )
+  {
+    AssertThat( ask( "" ), Equals( model ) );
+  }
+
+  It( answers_a_missing_path_with_an_error )
+  {
+    AssertThat( ask( "objects.99" ), Contains( "error" ) );
+  }
+
+  It( runs_an_exec_request_on_the_main_thread )
+  {
+    ask( "exec objects = {}" );
+    AssertThat( executed, Equals( "objects = {}" ) );
+  }
+
+  It( answers_an_exec_request_with_the_model_after_it )
+  {
+    ask( "" );
+    AssertThat( ask( "exec objects = {}" ), Equals( "{ \"executed\": true }" ) );
+  }
+
+  const std::string endpoint{ "ipc:///tmp/yarrrs_test_remote_model_server" };
+  std::string executed;
+  std::string model{ "{ \"objects\": { \"12\": { \"x\": 1 } }, \"clock\": 42 }" };
+  std::unique_ptr< test::Services > services;
+  std::unique_ptr< yarrrs::ModelSnapshot > snapshot;
+  std::unique_ptr< yarrrs::RemoteModelServer > server;
+  std::unique_ptr< test::ZmqClient > client;
+};
+
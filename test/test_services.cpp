@@ -28,6 +28,8 @@ Services::Services()
   , models( the::ctci::service< yarrrs::Models >() )
   , callback_queue_register()
   , main_thread_callback_queue( the::ctci::service< yarrr::MainThreadCallbackQueue >() )
+  , metrics_register()
+  , metrics( the::ctci::service< yarrrs::Metrics >() )
   , players()
   , objects()
   , command_handler()
@@ -13,6 +13,7 @@
 #include "../src/player.hpp"
 #include "../src/command_handler.hpp"
 #include "../src/local_event_dispatcher.hpp"
+#include "../src/metrics.hpp"
 #include "../src/world.hpp"
 #include <yarrr/test_connection.hpp>
 #include <sstream>
@@ -38,14 +39,16 @@ class Services
     yarrrs::Models& models;
     the::ctci::AutoServiceRegister< yarrr::MainThreadCallbackQueue, yarrr::MainThreadCallbackQueue > callback_queue_register;
     yarrr::MainThreadCallbackQueue& main_thread_callback_queue;
+    the::ctci::AutoServiceRegister< yarrrs::Metrics, yarrrs::Metrics > metrics_register;
+    yarrrs::Metrics& metrics;
     yarrrs::Player::Container players;
     yarrr::ObjectContainer objects;
     yarrrs::CommandHandler command_handler;
     std::unique_ptr< yarrrs::World > world;
 
-    void reset_world()
+    void reset_world( yarrrs::Cluster* cluster = nullptr )
     {
-      world = std::make_unique< yarrrs::World >( players, objects );
+      world = std::make_unique< yarrrs::World >( players, objects, cluster );
     }
 
     void dump_modell() const
@@ -0,0 +1,81 @@
+#include "../src/ship_pool.hpp"
+
+#include <yarrr/object.hpp>
+#include <yarrr/object_factory.hpp>
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( a_ship_pool )
+{
+  void SetUp()
+  {
+    factory = std::make_unique< yarrr::ObjectFactory >();
+    number_of_ships_built = 0;
+    factory->register_creator( ship_type,
+        [ this ]()
+        {
+          ++number_of_ships_built;
+          return yarrr::Object::create();
+        } );
+
+    pool = std::make_unique< yarrrs::ShipPool >( *factory, spares_per_type );
+  }
+
+  It ( builds_ships_with_the_factory_when_there_are_no_spares )
+  {
+    AssertThat( pool->acquire( ship_type ) != nullptr, Equals( true ) );
+    AssertThat( number_of_ships_built, Equals( 1u ) );
+  }
+
+  It ( returns_null_for_unknown_types )
+  {
+    AssertThat( pool->acquire( "rubber duck" ) == nullptr, Equals( true ) );
+  }
+
+  It ( builds_spares_of_kept_types_on_refill )
+  {
+    pool->keep_spares_of( ship_type );
+    pool->refill( 100 );
+    AssertThat( pool->spares_of( ship_type ), Equals( spares_per_type ) );
+  }
+
+  It ( builds_at_most_budget_ships_in_a_refill )
+  {
+    pool->keep_spares_of( ship_type );
+    pool->refill( 1 );
+    AssertThat( pool->spares_of( ship_type ), Equals( 1u ) );
+  }
+
+  It ( hands_out_spares_without_running_the_factory )
+  {
+    pool->keep_spares_of( ship_type );
+    pool->refill( 100 );
+    number_of_ships_built = 0;
+
+    AssertThat( pool->acquire( ship_type ) != nullptr, Equals( true ) );
+    AssertThat( number_of_ships_built, Equals( 0u ) );
+    AssertThat( pool->spares_of( ship_type ), Equals( spares_per_type - 1 ) );
+  }
+
+  It ( starts_keeping_spares_of_acquired_types )
+  {
+    pool->acquire( ship_type );
+    pool->refill( 100 );
+    AssertThat( pool->spares_of( ship_type ), Equals( spares_per_type ) );
+  }
+
+  It ( forgets_types_the_factory_cannot_build )
+  {
+    pool->keep_spares_of( "rubber duck" );
+    pool->refill( 100 );
+    AssertThat( pool->spares_of( "rubber duck" ), Equals( 0u ) );
+  }
+
+  const std::string ship_type{ "ship" };
+  const size_t spares_per_type{ 3 };
+  size_t number_of_ships_built;
+  std::unique_ptr< yarrr::ObjectFactory > factory;
+  std::unique_ptr< yarrrs::ShipPool > pool;
+};
+
@@ -0,0 +1,65 @@
+#include "../src/tick_histogram.hpp"
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( a_tick_histogram )
+{
+  void SetUp()
+  {
+    histogram = std::make_unique< yarrrs::TickHistogram >( std::chrono::milliseconds( 1 ), 100 );
+  }
+
+  void record_milliseconds( int from, int to )
+  {
+    for ( int i( from ); i < to; ++i )
+    {
+      histogram->record( std::chrono::microseconds( i * 1000 + 500 ) );
+    }
+  }
+
+  It ( counts_recorded_durations )
+  {
+    record_milliseconds( 0, 10 );
+    AssertThat( histogram->count(), Equals( 10u ) );
+  }
+
+  It ( tracks_the_maximum_exactly )
+  {
+    histogram->record( std::chrono::microseconds( 1234 ) );
+    histogram->record( std::chrono::seconds( 2 ) );
+    AssertThat( histogram->max().count(), Equals( 2000000 ) );
+  }
+
+  It ( gives_the_upper_bound_of_the_bucket_of_a_percentile )
+  {
+    record_milliseconds( 0, 100 );
+    AssertThat( histogram->percentile( 50 ).count(), Equals( 50000 ) );
+    AssertThat( histogram->percentile( 90 ).count(), Equals( 90000 ) );
+  }
+
+  It ( falls_back_to_the_maximum_for_percentiles_beyond_the_last_bucket )
+  {
+    record_milliseconds( 0, 10 );
+    histogram->record( std::chrono::seconds( 1 ) );
+    AssertThat( histogram->percentile( 100 ).count(), Equals( 1000000 ) );
+  }
+
+  It ( forgets_everything_when_reset )
+  {
+    record_milliseconds( 0, 10 );
+    histogram->reset();
+    AssertThat( histogram->count(), Equals( 0u ) );
+    AssertThat( histogram->max().count(), Equals( 0 ) );
+  }
+
+  It ( summarizes_percentiles_and_maximum )
+  {
+    record_milliseconds( 0, 10 );
+    AssertThat( histogram->summary(), Contains( "p99" ) );
+    AssertThat( histogram->summary(), Contains( "max" ) );
+  }
+
+  std::unique_ptr< yarrrs::TickHistogram > histogram;
+};
+
@@ -0,0 +1,98 @@
+#include "../src/timing_wheel.hpp"
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( a_timing_wheel )
+{
+  void SetUp()
+  {
+    wheel = std::make_unique< yarrrs::TimingWheel >( number_of_slots );
+    visited_keys.clear();
+  }
+
+  void tick()
+  {
+    wheel->tick( [ this ]( yarrrs::TimingWheel::Key key ){ visited_keys.push_back( key ); } );
+  }
+
+  void tick_a_whole_period()
+  {
+    for ( size_t i( 0 ); i < number_of_slots; ++i )
+    {
+      tick();
+    }
+  }
+
+  It ( visits_every_key_once_in_a_period )
+  {
+    for ( int key( 0 ); key < 10; ++key )
+    {
+      wheel->add( key );
+    }
+
+    tick_a_whole_period();
+    AssertThat( visited_keys, HasLength( 10 ) );
+  }
+
+  It ( spreads_keys_evenly_between_the_slots )
+  {
+    for ( int key( 0 ); key < 8; ++key )
+    {
+      wheel->add( key );
+    }
+
+    for ( size_t slot( 0 ); slot < number_of_slots; ++slot )
+    {
+      AssertThat( wheel->size_of_slot( slot ), Equals( 2u ) );
+    }
+  }
+
+  It ( visits_only_one_slot_in_a_tick )
+  {
+    for ( int key( 0 ); key < 8; ++key )
+    {
+      wheel->add( key );
+    }
+
+    tick();
+    AssertThat( visited_keys, HasLength( 2 ) );
+  }
+
+  It ( ignores_keys_added_twice )
+  {
+    wheel->add( 1 );
+    wheel->add( 1 );
+    AssertThat( wheel->size(), Equals( 1u ) );
+  }
+
+  It ( does_not_visit_removed_keys )
+  {
+    wheel->add( 1 );
+    wheel->add( 2 );
+    wheel->remove( 1 );
+    tick_a_whole_period();
+    AssertThat( visited_keys, HasLength( 1 ) );
+    AssertThat( visited_keys, Contains( 2 ) );
+  }
+
+  It ( fills_the_slots_emptied_by_removal_first )
+  {
+    for ( int key( 0 ); key < 4; ++key )
+    {
+      wheel->add( key );
+    }
+
+    wheel->remove( 2 );
+    wheel->add( 100 );
+    for ( size_t slot( 0 ); slot < number_of_slots; ++slot )
+    {
+      AssertThat( wheel->size_of_slot( slot ), Equals( 1u ) );
+    }
+  }
+
+  const size_t number_of_slots{ 4 };
+  std::unique_ptr< yarrrs::TimingWheel > wheel;
+  std::vector< yarrrs::TimingWheel::Key > visited_keys;
+};
+
@@ -0,0 +1,58 @@
+#include "../src/worker_pool.hpp"
+#include <igloo/igloo_alt.h>
+
+#include <atomic>
+
+using namespace igloo;
+
+Describe( a_worker_pool )
+{
+  std::vector< yarrrs::WorkerPool::Task > tasks_counting_to( int number_of_tasks )
+  {
+    std::vector< yarrrs::WorkerPool::Task > tasks;
+    for ( int i( 0 ); i < number_of_tasks; ++i )
+    {
+      tasks.push_back( [ this ]() { ++finished_tasks; } );
+    }
+
+    return tasks;
+  }
+
+  void SetUp()
+  {
+    finished_tasks = 0;
+  }
+
+  It( runs_every_task_before_returning )
+  {
+    yarrrs::WorkerPool pool( 3 );
+    pool.run( tasks_counting_to( 100 ) );
+    AssertThat( finished_tasks.load(), Equals( 100 ) );
+  }
+
+  It( runs_the_tasks_on_the_calling_thread_without_workers )
+  {
+    yarrrs::WorkerPool pool( 0 );
+    pool.run( tasks_counting_to( 10 ) );
+    AssertThat( finished_tasks.load(), Equals( 10 ) );
+  }
+
+  It( runs_batch_after_batch )
+  {
+    yarrrs::WorkerPool pool( 2 );
+    for ( int batch( 0 ); batch < 50; ++batch )
+    {
+      pool.run( tasks_counting_to( batch % 7 ) );
+    }
+
+    int expected_tasks( 0 );
+    for ( int batch( 0 ); batch < 50; ++batch )
+    {
+      expected_tasks += batch % 7;
+    }
+    AssertThat( finished_tasks.load(), Equals( expected_tasks ) );
+  }
+
+  std::atomic< int > finished_tasks;
+};
+
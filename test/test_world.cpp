@@ -175,6 +175,7 @@ Describe( a_world )
 
     auto another_player( services->log_in_player( "asdf" ) );
     test::Connection& another_connection( another_player->connection );
+    services->players[ another_connection.connection->id ]->queue_object_update( deleted_ship, yarrr::Data( 8, 'a' ) );
 
     local_dispatch( yarrrs::PlayerLoggedOut( connection_id ) );
     services->main_thread_callback_queue.process_callbacks();
@@ -240,10 +241,11 @@ Describe( a_world )
     AssertThat( services->objects.has_object_with_id( last_object_id_created ), Equals( false ) );
   }
 
-  It ( sends_delete_object_to_all_registered_players )
+  It ( sends_delete_object_to_all_players_shown_the_object )
   {
     auto another_player( services->log_in_player( "asdf" ) );
     test::Connection& another_connection( another_player->connection );
+    services->players[ another_connection.connection->id ]->queue_object_update( last_object_id_created, yarrr::Data( 8, 'a' ) );
 
     connection->flush_connection();
     another_connection.flush_connection();
@@ -259,6 +261,23 @@ Describe( a_world )
     AssertThat( connection->get_entity< yarrr::DeleteObject >()->object_id(), Equals( last_object_id_created ) );
   }
 
+  It ( deletes_an_object_requested_to_be_deleted_more_times_only_once )
+  {
+    connection->flush_connection();
+    engine_dispatch( yarrr::DeleteObject( last_object_id_created ) );
+    engine_dispatch( yarrr::DeleteObject( last_object_id_created ) );
+    services->main_thread_callback_queue.process_callbacks();
+
+    AssertThat( services->objects.has_object_with_id( last_object_id_created ), Equals( false ) );
+    AssertThat( connection->entities< yarrr::DeleteObject >(), HasLength( 1 ) );
+  }
+
+
+  It ( exports_the_number_of_logged_in_players )
+  {
+    auto another_player( services->log_in_player( "asdf" ) );
+    AssertThat( services->metrics.gauge( "yarrr_logged_in_players", "" ).get(), Equals( 2.0 ) );
+  }
 
   It ( notifies_players_when_someone_logs_in )
   {
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <zmq.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+//A zmq socket of its own context connected to an endpoint under test.
+class ZmqClient
+{
+  public:
+    ZmqClient( int socket_type, const std::string& endpoint )
+      : m_context( zmq_ctx_new() )
+      , m_socket( zmq_socket( m_context, socket_type ) )
+    {
+      const int linger( 0 );
+      zmq_setsockopt( m_socket, ZMQ_LINGER, &linger, sizeof( linger ) );
+      zmq_connect( m_socket, endpoint.c_str() );
+    }
+
+    ~ZmqClient()
+    {
+      zmq_close( m_socket );
+      zmq_ctx_term( m_context );
+    }
+
+    ZmqClient( const ZmqClient& ) = delete;
+    ZmqClient& operator=( const ZmqClient& ) = delete;
+
+    void* socket()
+    {
+      return m_socket;
+    }
+
+    void send( const std::string& message )
+    {
+      zmq_send( m_socket, message.data(), message.size(), 0 );
+    }
+
+    //calls while_waiting between the polls, e.g. to publish snapshots like
+    //the main thread does, returns the frames of the message, or nothing
+    //when no message came in time
+    std::vector< std::string > receive( const std::function< void() >& while_waiting )
+    {
+      for ( int polls( 0 ); polls < 500; ++polls )
+      {
+        while_waiting();
+        zmq_pollitem_t item{ m_socket, 0, ZMQ_POLLIN, 0 };
+        if ( zmq_poll( &item, 1, 10 ) > 0 && ( item.revents & ZMQ_POLLIN ) )
+        {
+          return receive_frames();
+        }
+      }
+
+      return {};
+    }
+
+  private:
+    std::vector< std::string > receive_frames()
+    {
+      std::vector< std::string > frames;
+      zmq_msg_t frame;
+      zmq_msg_init( &frame );
+      while ( zmq_msg_recv( &frame, m_socket, 0 ) >= 0 )
+      {
+        frames.emplace_back( static_cast< const char* >( zmq_msg_data( &frame ) ), zmq_msg_size( &frame ) );
+        if ( !zmq_msg_more( &frame ) )
+        {
+          break;
+        }
+      }
+
+      zmq_msg_close( &frame );
+      return frames;
+    }
+
+    void* m_context;
+    void* m_socket;
+};
+
+}
+
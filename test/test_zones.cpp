@@ -0,0 +1,108 @@
+#include "../src/zones.hpp"
+#include "../src/worker_pool.hpp"
+#include "test_services.hpp"
+
+#include <yarrr/object.hpp>
+#include <yarrr/object_container.hpp>
+#include <yarrr/basic_behaviors.hpp>
+#include <igloo/igloo_alt.h>
+
+using namespace igloo;
+
+Describe( zones )
+{
+  void SetUp()
+  {
+    services = std::make_unique< test::Services >();
+    workers = std::make_unique< yarrrs::WorkerPool >( 2 );
+    zones = std::make_unique< yarrrs::Zones >( zone_size, *workers );
+  }
+
+  void TearDown()
+  {
+    zones.reset();
+    workers.reset();
+    services.reset();
+  }
+
+  yarrr::PhysicalParameters& add_object_at( yarrr::Coordinate::type x, yarrr::Coordinate::type y )
+  {
+    yarrr::Object::Pointer object( new yarrr::Object() );
+    object->add_behavior( std::make_unique< yarrr::PhysicalBehavior >() );
+    auto& physical_parameters( yarrr::component_of< yarrr::PhysicalBehavior >( *object ).physical_parameters );
+    physical_parameters.coordinate = yarrr::Coordinate( x, y );
+    ids.push_back( object->id() );
+    services->objects.add_object( std::move( object ) );
+    return physical_parameters;
+  }
+
+  yarrrs::Zones::Updates assign()
+  {
+    yarrrs::Zones::Updates updates( services->objects.generate_object_updates() );
+    zones->assign( services->objects, updates );
+    return updates;
+  }
+
+  It( puts_negative_coordinates_into_negative_zones )
+  {
+    AssertThat( zones->zone_of( yarrr::Coordinate( -1, zone_size ) ), Equals( yarrrs::Zones::Key( -1, 1 ) ) );
+    AssertThat( zones->zone_of( yarrr::Coordinate( zone_size - 1, 0 ) ), Equals( yarrrs::Zones::Key( 0, 0 ) ) );
+  }
+
+  It( calls_the_surrounding_zones_neighbors )
+  {
+    AssertThat( yarrrs::Zones::are_neighbors( { 0, 0 }, { 1, -1 } ), Equals( true ) );
+    AssertThat( yarrrs::Zones::are_neighbors( { 0, 0 }, { 2, 0 } ), Equals( false ) );
+  }
+
+  It( assigns_objects_to_the_zone_they_are_in )
+  {
+    add_object_at( 10, 10 );
+    add_object_at( -10, 3 * zone_size );
+    assign();
+
+    yarrrs::Zones::Key zone;
+    AssertThat( zones->zone_of_object( ids[ 1 ], zone ), Equals( true ) );
+    AssertThat( zone, Equals( yarrrs::Zones::Key( -1, 3 ) ) );
+    AssertThat( zones->number_of_zones(), Equals( 2u ) );
+  }
+
+  It( moves_and_counts_objects_crossing_a_border )
+  {
+    yarrr::PhysicalParameters& physical_parameters( add_object_at( zone_size - 1, 0 ) );
+    assign();
+    physical_parameters.coordinate.x += 2;
+    assign();
+
+    yarrrs::Zones::Key zone;
+    zones->zone_of_object( ids[ 0 ], zone );
+    AssertThat( zone, Equals( yarrrs::Zones::Key( 1, 0 ) ) );
+    AssertThat( services->metrics.counter( "yarrr_zone_border_crossings_total", "" ).get(), Equals( 1.0 ) );
+  }
+
+  It( serializes_the_needed_updates_in_order )
+  {
+    for ( int i( 0 ); i < 20; ++i )
+    {
+      add_object_at( i * zone_size, 0 );
+    }
+
+    const yarrrs::Zones::Updates updates( assign() );
+    std::vector< bool > is_needed( updates.size(), true );
+    is_needed[ 3 ] = false;
+    const std::vector< yarrr::Data > serialized( zones->serialize( updates, is_needed ) );
+    AssertThat( serialized, HasLength( updates.size() ) );
+    AssertThat( serialized[ 3 ], IsEmpty() );
+    for ( size_t i( 4 ); i < updates.size(); ++i )
+    {
+      AssertThat( serialized[ i ], Equals( updates[ i ]->serialize() ) );
+    }
+  }
+
+  const int64_t zone_size{ 1000 };
+  std::unique_ptr< test::Services > services;
+  std::unique_ptr< yarrrs::WorkerPool > workers;
+  std::unique_ptr< yarrrs::Zones > zones;
+  std::vector< yarrr::Object::Id > ids;
+};
+